@@ -0,0 +1,849 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <chrono>
+#include <optional>
+#include <random>
+#include <cfloat>
+#include <memory_resource>
+#include "../Serialization/Serialization.hpp"
+
+// Usage: Benchmark [scale] [repetitions]
+// Writes one CSV row per case, stream and operation to stdout.
+
+using Clock = std::chrono::steady_clock;
+
+static double s_Scale = 1.0;
+static int    s_Repetitions = 5;
+static bool   s_Failed = false;
+
+static const char* s_Path = "Benchmark.bin";
+
+struct Vector3
+{
+	float X, Y, Z;
+};
+
+struct Record
+{
+	uint64_t              Id;
+	std::string           Name;
+	std::vector< float >  Values;
+
+	template < typename _Serializer >
+	void Serialize( _Serializer& a_Serializer ) const
+	{
+		a_Serializer << Id << Name << Values;
+	}
+
+	template < typename _Deserializer >
+	void Deserialize( _Deserializer& a_Deserializer )
+	{
+		a_Deserializer >> Id >> Name >> Values;
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer& Id& Name& Values;
+	}
+};
+
+struct Hooked
+{
+	int32_t Value;
+	int32_t Checksum;
+
+	void OnBeforeSerialize()
+	{
+		Checksum = Value * 31;
+	}
+
+	void OnAfterDeserialize()
+	{
+		Checksum = 0;
+	}
+};
+
+struct Samples
+{
+	float Values[ 4096 ];
+
+	template < typename _Serializer >
+	void Serialize( _Serializer& a_Serializer ) const
+	{
+		a_Serializer << &Values;
+	}
+
+	template < typename _Deserializer >
+	void Deserialize( _Deserializer& a_Deserializer )
+	{
+		float( *Pointer )[ 4096 ] = &Values;
+		a_Deserializer >> Pointer;
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer& &Values;
+	}
+};
+
+template < typename _Stream >
+struct StreamName;
+
+template <> struct StreamName< BufferStream >       { static constexpr const char* Value = "BufferStream"; };
+template <> struct StreamName< FileStream >         { static constexpr const char* Value = "FileStream"; };
+template <> struct StreamName< BufferedFileStream > { static constexpr const char* Value = "BufferedFileStream"; };
+template <> struct StreamName< MMapStream >         { static constexpr const char* Value = "MMapStream"; };
+template <> struct StreamName< GatherStream >       { static constexpr const char* Value = "GatherStream"; };
+template <> struct StreamName< AsyncFileStream >    { static constexpr const char* Value = "AsyncFileStream"; };
+
+template < typename _Stream >
+static constexpr auto CanViewImpl( _Stream* ) -> decltype( std::declval< _Stream& >().View( 0 ), true )
+{
+	return true;
+}
+
+template < typename >
+static constexpr bool CanViewImpl( ... )
+{
+	return false;
+}
+
+template < typename _Stream >
+static constexpr bool CanView = CanViewImpl< _Stream >( nullptr );
+
+template < typename T >
+struct IsView : std::false_type {};
+
+template < typename... Args >
+struct IsView< std::basic_string_view< Args... > > : std::true_type {};
+
+template < typename T >
+struct IsView< Span< T > > : std::true_type {};
+
+static size_t Scaled( size_t a_Count )
+{
+	size_t Count = ( size_t )( a_Count * s_Scale );
+	return Count ? Count : 1;
+}
+
+template < typename _Setup, typename _Run, typename _Teardown >
+static double Measure( _Setup&& a_Setup, _Run&& a_Run, _Teardown&& a_Teardown )
+{
+	double Best = DBL_MAX;
+
+	for ( int i = 0; i < s_Repetitions; ++i )
+	{
+		a_Setup();
+		auto Start = Clock::now();
+		a_Run();
+		double Seconds = std::chrono::duration< double >( Clock::now() - Start ).count();
+		a_Teardown();
+		Best = Seconds < Best ? Seconds : Best;
+	}
+
+	return Best;
+}
+
+static void Report( const char* a_Case, const char* a_Stream, const char* a_Operation, size_t a_Elements, size_t a_Bytes, double a_Seconds )
+{
+	printf( "\"%s\",%s,%s,%zu,%zu,%.9f,%.3f,%.3f\n",
+		a_Case, a_Stream, a_Operation, a_Elements, a_Bytes, a_Seconds,
+		a_Seconds > 0.0 ? a_Bytes / a_Seconds / 1e6 : 0.0,
+		a_Elements ? a_Seconds * 1e9 / a_Elements : 0.0 );
+	fflush( stdout );
+}
+
+// Reports an operation whose output differs from the bytes expected of it, and fails the run.
+static void Check( const char* a_Case, const char* a_Operation, const BufferStream& a_Expected, const BufferStream& a_Actual )
+{
+	if ( a_Expected.Size() != a_Actual.Size() || ( a_Expected.Size() && memcmp( a_Expected.Data(), a_Actual.Data(), a_Expected.Size() ) ) )
+	{
+		fprintf( stderr, "\"%s\" %s: output differs from the source data.\n", a_Case, a_Operation );
+		s_Failed = true;
+	}
+}
+
+static void Prepare( const uint8_t* a_Data, size_t a_Size )
+{
+	FILE* File = fopen( s_Path, "wb" );
+
+	if ( a_Size )
+	{
+		fwrite( a_Data, 1, a_Size, File );
+	}
+
+	fclose( File );
+}
+
+template < typename _Stream, typename T >
+static void RunStream( const char* a_Case, const T& a_Data, size_t a_Elements, const BufferStream& a_Image )
+{
+	const char* Name = StreamName< _Stream >::Value;
+	size_t Bytes = a_Image.Size();
+
+	{
+		std::optional< StreamSerializer< _Stream > > Serializer;
+
+		double Seconds = Measure(
+			[&]()
+			{
+				if constexpr ( std::is_same_v< _Stream, BufferStream > )
+				{
+					Serializer.emplace();
+				}
+				else
+				{
+					Prepare( nullptr, 0 );
+					Serializer.emplace();
+				}
+			},
+			[&]()
+			{
+				if constexpr ( !std::is_same_v< _Stream, BufferStream > )
+				{
+					Serializer->Open( s_Path );
+				}
+
+				*Serializer << a_Data;
+				Serializer->Close();
+			},
+			[&]()
+			{
+				Serializer.reset();
+			} );
+
+		Report( a_Case, Name, "serialize", a_Elements, Bytes, Seconds );
+	}
+
+	if constexpr ( !IsView< T >::value || CanView< _Stream > )
+	{
+		std::optional< StreamDeserializer< _Stream > > Deserializer;
+		std::optional< T > Result;
+
+		if constexpr ( !std::is_same_v< _Stream, BufferStream > )
+		{
+			Prepare( a_Image.Data(), Bytes );
+		}
+
+		double Seconds = Measure(
+			[&]()
+			{
+				Deserializer.emplace();
+				Result.emplace();
+
+				if constexpr ( std::is_same_v< _Stream, BufferStream > )
+				{
+					Deserializer->GetStream().Open( Bytes );
+					Deserializer->GetStream().Write( a_Image.Data(), Bytes );
+					Deserializer->GetStream().Seek( 0 );
+				}
+			},
+			[&]()
+			{
+				if constexpr ( !std::is_same_v< _Stream, BufferStream > )
+				{
+					Deserializer->Open( s_Path );
+				}
+
+				*Deserializer >> *Result;
+			},
+			[&]()
+			{
+				Result.reset();
+				Deserializer.reset();
+			} );
+
+		Report( a_Case, Name, "deserialize", a_Elements, Bytes, Seconds );
+	}
+}
+
+template < typename T >
+static void RunCompressed( const char* a_Case, const T& a_Data, size_t a_Elements, size_t a_Bytes )
+{
+	for ( size_t Threads : { 1, 0 } )
+	{
+		std::optional< CompressedFileSerializer > Serializer;
+
+		double Seconds = Measure(
+			[&]()
+			{
+				Prepare( nullptr, 0 );
+				Serializer.emplace();
+			},
+			[&]()
+			{
+				Serializer->Open( s_Path );
+				Serializer->GetStream().SetParallelism( Threads );
+				*Serializer << a_Data;
+				Serializer->Close();
+			},
+			[&]()
+			{
+				Serializer.reset();
+			} );
+
+		Report( a_Case, "CompressedFileStream", Threads == 1 ? "serialize" : "serialize_parallel", a_Elements, a_Bytes, Seconds );
+	}
+
+	std::optional< CompressedFileDeserializer > Deserializer;
+	std::optional< T > Result;
+
+	double Seconds = Measure(
+		[&]()
+		{
+			Deserializer.emplace();
+			Result.emplace();
+		},
+		[&]()
+		{
+			Deserializer->Open( s_Path );
+			*Deserializer >> *Result;
+		},
+		[&]()
+		{
+			Result.reset();
+			Deserializer.reset();
+		} );
+
+	Report( a_Case, "CompressedFileStream", "deserialize", a_Elements, a_Bytes, Seconds );
+}
+
+template < typename T >
+static void Run( const char* a_Case, const T& a_Data, size_t a_Elements )
+{
+	BufferSerializer Image;
+	Image << a_Data;
+
+	size_t Bytes = Image.GetStream().Size();
+	volatile size_t Sink = 0;
+
+	double Seconds = Measure( []() {}, [&]() { Sink = Sink + Serialization::GetSizeOf( a_Data ); }, []() {} );
+	Report( a_Case, "StreamSizer", "sizeof", a_Elements, Bytes, Seconds );
+
+	RunStream< BufferStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+	RunStream< FileStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+	RunStream< BufferedFileStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+	RunStream< MMapStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+	RunStream< GatherStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+	RunStream< AsyncFileStream >( a_Case, a_Data, a_Elements, Image.GetStream() );
+
+	if constexpr ( !IsView< T >::value )
+	{
+		RunCompressed( a_Case, a_Data, a_Elements, Bytes );
+	}
+}
+
+template < typename T >
+static void RunParallel( const char* a_Case, const T& a_Data, size_t a_Elements )
+{
+	std::optional< BufferSerializer > Serializer;
+	size_t Bytes = 0;
+
+	double Seconds = Measure(
+		[&]()
+		{
+			Serializer.emplace();
+			Serializer->SetParallelism( 0 );
+		},
+		[&]()
+		{
+			*Serializer << a_Data;
+			Bytes = Serializer->GetStream().Size();
+		},
+		[&]()
+		{
+			Serializer.reset();
+		} );
+
+	Report( a_Case, "BufferStream", "serialize_parallel", a_Elements, Bytes, Seconds );
+
+	BufferSerializer Image;
+	Image.SetChunkIndex( 4096 );
+	Image << a_Data;
+
+	std::optional< ViewDeserializer > Deserializer;
+	std::optional< T > Result;
+
+	Seconds = Measure(
+		[&]()
+		{
+			Deserializer.emplace( Image.GetStream().Data(), Image.GetStream().Size() );
+			Deserializer->SetChunkIndex( true );
+			Deserializer->SetParallelism( 0 );
+			Result.emplace();
+		},
+		[&]()
+		{
+			*Deserializer >> *Result;
+		},
+		[&]()
+		{
+			Result.reset();
+			Deserializer.reset();
+		} );
+
+	Report( a_Case, "ViewStream", "deserialize_parallel", a_Elements, Image.GetStream().Size(), Seconds );
+}
+
+// Writes and reads in the byte order opposite to the host's, which is the cost a foreign host pays for portable files.
+template < typename T >
+static void RunSwapped( const char* a_Case, const T& a_Data, size_t a_Elements )
+{
+	ByteOrder Foreign = Serialization::HostByteOrder == ByteOrder::Little ? ByteOrder::Big : ByteOrder::Little;
+	std::optional< BufferSerializer > Serializer;
+	size_t Bytes = 0;
+
+	double Seconds = Measure(
+		[&]()
+		{
+			Serializer.emplace();
+			Serializer->SetByteOrder( Foreign );
+		},
+		[&]()
+		{
+			*Serializer << a_Data;
+			Bytes = Serializer->GetStream().Size();
+		},
+		[&]()
+		{
+			Serializer.reset();
+		} );
+
+	Report( a_Case, "BufferStream", "serialize_swapped", a_Elements, Bytes, Seconds );
+
+	BufferSerializer Image;
+	Image.SetByteOrder( Foreign );
+	Image << a_Data;
+
+	std::optional< ViewDeserializer > Deserializer;
+	std::optional< T > Result;
+
+	Seconds = Measure(
+		[&]()
+		{
+			Deserializer.emplace( Image.GetStream().Data(), Image.GetStream().Size() );
+			Deserializer->SetByteOrder( Foreign );
+			Result.emplace();
+		},
+		[&]()
+		{
+			*Deserializer >> *Result;
+		},
+		[&]()
+		{
+			Result.reset();
+			Deserializer.reset();
+		} );
+
+	Report( a_Case, "ViewStream", "deserialize_swapped", a_Elements, Image.GetStream().Size(), Seconds );
+}
+
+// Encodes every element as its own message, once with a new serializer per message and once with one leased from a pool.
+template < typename T >
+static void RunMessages( const char* a_Case, const std::vector< T >& a_Data )
+{
+	size_t Bytes = 0;
+
+	double Seconds = Measure(
+		[&]() { Bytes = 0; },
+		[&]()
+		{
+			for ( const auto& Element : a_Data )
+			{
+				BufferSerializer Serializer;
+				Serializer << Element;
+				Bytes += Serializer.GetStream().Size();
+			}
+		},
+		[&]() {} );
+
+	Report( a_Case, "BufferStream", "serialize_messages", a_Data.size(), Bytes, Seconds );
+
+	Seconds = Measure(
+		[&]() { Bytes = 0; },
+		[&]()
+		{
+			for ( const auto& Element : a_Data )
+			{
+				auto Lease = BufferPool::Local().Acquire();
+				*Lease << Element;
+				Bytes += Lease.GetStream().Size();
+			}
+		},
+		[&]() {} );
+
+	Report( a_Case, "BufferStream", "serialize_messages_pooled", a_Data.size(), Bytes, Seconds );
+}
+
+// Visits every element of a serialized container through ReadElements instead of loading the container.
+template < typename T >
+static void RunStreaming( const char* a_Case, const T& a_Data, size_t a_Elements )
+{
+	BufferSerializer Image;
+	Image << a_Data;
+
+	size_t Count = 0;
+
+	double Seconds = Measure(
+		[&]() { Count = 0; },
+		[&]()
+		{
+			ViewDeserializer Deserializer( Image.GetStream().Data(), Image.GetStream().Size() );
+
+			for ( auto& Element : Serialization::ReadElements< T >( Deserializer ) )
+			{
+				( void )Element;
+				++Count;
+			}
+		},
+		[&]() {} );
+
+	Report( a_Case, "ViewStream", "deserialize_streaming", a_Elements, Image.GetStream().Size(), Seconds );
+
+	// The reader reuses one element, so each must serialize exactly like the original or state leaked between them.
+	BufferSerializer Expected;
+	BufferSerializer Streamed;
+
+	for ( const auto& Element : a_Data )
+	{
+		Expected << Element;
+	}
+
+	ViewDeserializer Deserializer( Image.GetStream().Data(), Image.GetStream().Size() );
+
+	for ( auto& Element : Serialization::ReadElements< T >( Deserializer ) )
+	{
+		Streamed << Element;
+	}
+
+	Check( a_Case, "deserialize_streaming", Expected.GetStream(), Streamed.GetStream() );
+}
+
+// Appends every element to a block sequence one at a time and reads them back through a SequenceReader.
+template < typename T >
+static void RunAppend( const char* a_Case, const std::vector< T >& a_Data )
+{
+	std::optional< BufferSerializer > Serializer;
+
+	double Seconds = Measure(
+		[&]() { Serializer.emplace(); },
+		[&]()
+		{
+			SequenceWriter< T, BufferStream > Writer( *Serializer );
+
+			for ( const auto& Element : a_Data )
+			{
+				Writer.Append( Element );
+			}
+		},
+		[&]() {} );
+
+	Report( a_Case, "BufferStream", "serialize_append", a_Data.size(), Serializer->GetStream().Size(), Seconds );
+
+	size_t Count = 0;
+
+	Seconds = Measure(
+		[&]() { Count = 0; },
+		[&]()
+		{
+			ViewDeserializer Deserializer( Serializer->GetStream().Data(), Serializer->GetStream().Size() );
+
+			for ( auto& Element : SequenceReader< T, ViewStream >( Deserializer ) )
+			{
+				( void )Element;
+				++Count;
+			}
+		},
+		[&]() {} );
+
+	Report( a_Case, "ViewStream", "deserialize_append", Count, Serializer->GetStream().Size(), Seconds );
+
+	BufferSerializer Expected;
+	BufferSerializer Streamed;
+
+	for ( const auto& Element : a_Data )
+	{
+		Expected << Element;
+	}
+
+	ViewDeserializer Deserializer( Serializer->GetStream().Data(), Serializer->GetStream().Size() );
+
+	for ( auto& Element : SequenceReader< T, ViewStream >( Deserializer ) )
+	{
+		Streamed << Element;
+	}
+
+	Check( a_Case, "deserialize_append", Expected.GetStream(), Streamed.GetStream() );
+}
+
+// Loads into containers whose allocations all come from one monotonic arena, and times load plus teardown.
+template < typename T >
+static void RunArena( const char* a_Case, const T& a_Data, size_t a_Elements )
+{
+	BufferSerializer Image;
+	Image << a_Data;
+
+	std::optional< std::pmr::monotonic_buffer_resource > Arena;
+	std::optional< T > Result;
+
+	double Seconds = Measure(
+		[&]()
+		{
+			Arena.emplace( Image.GetStream().Size() * 2 );
+		},
+		[&]()
+		{
+			Result.emplace( &*Arena );
+			ViewDeserializer Deserializer( Image.GetStream().Data(), Image.GetStream().Size() );
+			Deserializer >> *Result;
+			Result.reset();
+			Arena->release();
+		},
+		[&]()
+		{
+			Arena.reset();
+		} );
+
+	Report( a_Case, "ViewStream", "deserialize_arena", a_Elements, Image.GetStream().Size(), Seconds );
+
+	Seconds = Measure(
+		[&]() {},
+		[&]()
+		{
+			Result.emplace();
+			ViewDeserializer Deserializer( Image.GetStream().Data(), Image.GetStream().Size() );
+			Deserializer >> *Result;
+			Result.reset();
+		},
+		[&]() {} );
+
+	Report( a_Case, "ViewStream", "deserialize_heap", a_Elements, Image.GetStream().Size(), Seconds );
+}
+
+static std::string MakeString( std::mt19937_64& a_Random, size_t a_Length )
+{
+	std::string String( a_Length, ' ' );
+
+	for ( auto& Character : String )
+	{
+		Character = ( char )( 'a' + a_Random() % 26 );
+	}
+
+	return String;
+}
+
+int main( int a_Argc, char** a_Argv )
+{
+	if ( a_Argc > 1 )
+	{
+		s_Scale = atof( a_Argv[ 1 ] );
+	}
+
+	if ( a_Argc > 2 )
+	{
+		s_Repetitions = atoi( a_Argv[ 2 ] );
+	}
+
+	printf( "case,stream,operation,elements,bytes,seconds,mb_per_s,ns_per_element\n" );
+
+	std::mt19937_64 Random( 42 );
+
+	{
+		std::vector< float > Data( Scaled( 8000000 ) );
+		for ( auto& Element : Data ) Element = ( float )( Random() % 1000 ) * 0.5f;
+		Run( "vector<float>", Data, Data.size() );
+		RunSwapped( "vector<float>", Data, Data.size() );
+	}
+
+	{
+		std::vector< Vector3 > Data( Scaled( 2000000 ) );
+		for ( auto& Element : Data ) Element = { ( float )Random(), ( float )Random(), ( float )Random() };
+		Run( "vector<Vector3>", Data, Data.size() );
+	}
+
+	{
+		std::vector< Hooked > Data( Scaled( 1000000 ) );
+		for ( auto& Element : Data ) Element.Value = ( int32_t )Random();
+		Run( "vector<Hooked>", Data, Data.size() );
+	}
+
+	{
+		std::vector< std::pair< int32_t, double > > Data( Scaled( 1000000 ) );
+		for ( auto& Element : Data ) Element = { ( int32_t )Random(), ( double )Random() };
+		Run( "vector<pair<int,double>>", Data, Data.size() );
+	}
+
+	{
+		std::array< int32_t, 4096 > Data;
+		for ( auto& Element : Data ) Element = ( int32_t )Random();
+		Run( "array<int,4096>", Data, Data.size() );
+	}
+
+	{
+		std::vector< Samples > Data( Scaled( 256 ) );
+		for ( auto& Element : Data ) for ( auto& Value : Element.Values ) Value = ( float )Random();
+		Run( "vector<float(*)[4096]>", Data, Data.size() * 4096 );
+	}
+
+	{
+		std::string Data = MakeString( Random, Scaled( 64000000 ) );
+		Run( "string", Data, Data.size() );
+
+		std::string_view View = Data;
+		Run( "string_view", View, View.size() );
+	}
+
+	{
+		std::vector< float > Storage( Scaled( 8000000 ), 1.0f );
+		Span< const float > Data( Storage );
+		Run( "Span<const float>", Data, Data.size() );
+	}
+
+	{
+		std::vector< std::string > Data( Scaled( 1000000 ) );
+		for ( auto& Element : Data ) Element = MakeString( Random, 4 + Random() % 28 );
+		Run( "vector<string>", Data, Data.size() );
+		RunParallel( "vector<string>", Data, Data.size() );
+	}
+
+	{
+		std::vector< std::tuple< int32_t, double, std::string > > Data( Scaled( 500000 ) );
+		for ( auto& Element : Data ) Element = { ( int32_t )Random(), ( double )Random(), MakeString( Random, 12 ) };
+		Run( "vector<tuple<int,double,string>>", Data, Data.size() );
+	}
+
+	{
+		std::vector< std::vector< int32_t > > Data( Scaled( 100000 ) );
+		for ( auto& Element : Data ) Element.assign( Random() % 64, ( int32_t )Random() );
+		Run( "vector<vector<int>>", Data, Data.size() );
+	}
+
+	{
+		std::vector< Record > Data( Scaled( 200000 ) );
+		for ( auto& Element : Data ) Element = { Random(), MakeString( Random, 16 ), std::vector< float >( Random() % 32, 1.0f ) };
+		Run( "vector<Record>", Data, Data.size() );
+		RunParallel( "vector<Record>", Data, Data.size() );
+		RunSwapped( "vector<Record>", Data, Data.size() );
+		RunMessages( "vector<Record>", Data );
+		RunStreaming( "vector<Record>", Data, Data.size() );
+		RunAppend( "vector<Record>", Data );
+	}
+
+	{
+		std::deque< int32_t > Data( Scaled( 2000000 ) );
+		for ( auto& Element : Data ) Element = ( int32_t )Random();
+		Run( "deque<int>", Data, Data.size() );
+	}
+
+	{
+		std::list< int32_t > Data( Scaled( 500000 ) );
+		for ( auto& Element : Data ) Element = ( int32_t )Random();
+		Run( "list<int>", Data, Data.size() );
+	}
+
+	{
+		std::forward_list< int32_t > Data( Scaled( 500000 ) );
+		for ( auto& Element : Data ) Element = ( int32_t )Random();
+		Run( "forward_list<int>", Data, Scaled( 500000 ) );
+	}
+
+	{
+		std::map< int32_t, std::string > Data;
+		while ( Data.size() < Scaled( 200000 ) ) Data.emplace( ( int32_t )Random(), MakeString( Random, 16 ) );
+		Run( "map<int,string>", Data, Data.size() );
+	}
+
+	{
+		std::map< std::string, std::vector< int32_t > > Data;
+		while ( Data.size() < Scaled( 50000 ) ) Data.emplace( MakeString( Random, 16 ), std::vector< int32_t >( Random() % 64, 7 ) );
+		Run( "map<string,vector<int>>", Data, Data.size() );
+		RunStreaming( "map<string,vector<int>>", Data, Data.size() );
+
+		std::pmr::map< std::pmr::string, std::pmr::vector< int32_t > > Pmr;
+		for ( auto& Pair : Data ) Pmr.try_emplace( std::pmr::string( Pair.first.c_str() ), Pair.second.begin(), Pair.second.end() );
+		RunArena( "pmr::map<string,vector<int>>", Pmr, Pmr.size() );
+	}
+
+	{
+		std::multimap< int32_t, int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 200000 ); ++i ) Data.emplace( ( int32_t )( Random() % 1000 ), ( int32_t )Random() );
+		Run( "multimap<int,int>", Data, Data.size() );
+	}
+
+	{
+		std::unordered_map< uint64_t, double > Data;
+		while ( Data.size() < Scaled( 500000 ) ) Data.emplace( Random(), ( double )Random() );
+		Run( "unordered_map<uint64,double>", Data, Data.size() );
+		RunParallel( "unordered_map<uint64,double>", Data, Data.size() );
+	}
+
+	{
+		std::map< int32_t, std::list< int32_t > > Data;
+		while ( Data.size() < Scaled( 50000 ) ) Data.emplace( ( int32_t )Random(), std::list< int32_t >( Random() % 16, 7 ) );
+		RunStreaming( "map<int,list<int>>", Data, Data.size() );
+	}
+
+	{
+		std::vector< std::pair< int32_t, std::deque< int32_t > > > Data( Scaled( 50000 ) );
+		for ( auto& Element : Data ) Element = { ( int32_t )Random(), std::deque< int32_t >( Random() % 16, 7 ) };
+		RunStreaming( "vector<pair<int,deque<int>>>", Data, Data.size() );
+		RunAppend( "vector<pair<int,deque<int>>>", Data );
+	}
+
+	{
+		std::unordered_multimap< int32_t, int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 200000 ); ++i ) Data.emplace( ( int32_t )( Random() % 1000 ), ( int32_t )Random() );
+		Run( "unordered_multimap<int,int>", Data, Data.size() );
+	}
+
+	{
+		std::set< std::string > Data;
+		while ( Data.size() < Scaled( 200000 ) ) Data.emplace( MakeString( Random, 16 ) );
+		Run( "set<string>", Data, Data.size() );
+	}
+
+	{
+		std::multiset< int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 500000 ); ++i ) Data.emplace( ( int32_t )( Random() % 1000 ) );
+		Run( "multiset<int>", Data, Data.size() );
+	}
+
+	{
+		std::unordered_set< uint64_t > Data;
+		while ( Data.size() < Scaled( 500000 ) ) Data.emplace( Random() );
+		Run( "unordered_set<uint64>", Data, Data.size() );
+	}
+
+	{
+		std::unordered_multiset< int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 500000 ); ++i ) Data.emplace( ( int32_t )( Random() % 1000 ) );
+		Run( "unordered_multiset<int>", Data, Data.size() );
+	}
+
+	{
+		std::stack< int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 1000000 ); ++i ) Data.push( ( int32_t )Random() );
+		Run( "stack<int>", Data, Data.size() );
+	}
+
+	{
+		std::queue< int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 1000000 ); ++i ) Data.push( ( int32_t )Random() );
+		Run( "queue<int>", Data, Data.size() );
+	}
+
+	{
+		std::priority_queue< int32_t > Data;
+		for ( size_t i = 0; i < Scaled( 1000000 ); ++i ) Data.push( ( int32_t )Random() );
+		Run( "priority_queue<int>", Data, Data.size() );
+	}
+
+	remove( s_Path );
+
+#ifdef SERIALIZATION_INSTRUMENT
+	Instrumentation::Dump( stderr );
+#endif
+
+	return s_Failed ? 1 : 0;
+}
@@ -1,10 +1,19 @@
 #pragma once
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <type_traits>
+#include <stdexcept>
+#include <new>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <array>
 #include <deque>
 #include <forward_list>
+#include <iterator>
+#include <memory>
 #include <list>
 #include <vector>
 #include <map>
@@ -13,6 +22,90 @@
 #include <unordered_set>
 #include <stack>
 #include <queue>
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <exception>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+#if defined( __linux__ ) && !defined( SERIALIZATION_NO_IO_URING ) && defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter )
+#define SERIALIZATION_IO_URING
+#endif
+#endif
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <immintrin.h>
+#define SERIALIZATION_SSE2
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+#include <arm_neon.h>
+#define SERIALIZATION_NEON
+#endif
+
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SERIALIZATION_BIG_ENDIAN
+#endif
+
+#ifdef SERIALIZATION_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef SERIALIZATION_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef SERIALIZATION_INSTRUMENT
+#include <chrono>
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <crtdbg.h>
+#define SERIALIZATION_ASSERT( Expression, Message ) _ASSERT_EXPR( Expression, _CRT_WIDE( Message ) )
+#else
+#include <assert.h>
+#define SERIALIZATION_ASSERT( Expression, Message ) assert( ( Expression ) && Message )
+#endif
+
+// Checks that must also hold in release builds, where they throw instead of asserting.
+#define SERIALIZATION_CHECK( Expression, Message ) \
+	do \
+	{ \
+		if ( !( Expression ) ) \
+		{ \
+			SERIALIZATION_ASSERT( false, Message ); \
+			throw std::runtime_error( Message ); \
+		} \
+	} \
+	while ( false )
 
 template < typename >
 class Serializer;
@@ -20,8 +113,425 @@ class Serializer;
 template < typename >
 class Deserializer;
 
+template < typename >
+class DeltaSerializer;
+
+template < typename, typename >
+class ElementReader;
+
 class StreamSizer;
 
+enum class SizeEncoding
+{
+	Fixed,
+	Varint
+};
+
+enum class ByteOrder
+{
+	Native,
+	Little,
+	Big
+};
+
+// Runs batches of tasks on threads that live as long as the pool, with the calling thread taking part. A batch started
+// from inside a task runs on that thread alone, so nested parallel work never waits on the pool it is running on.
+class ThreadPool
+{
+	struct Batch
+	{
+		void*                 Context;
+		void               ( *Invoke )( void*, size_t );
+		size_t                Count;
+		std::atomic< size_t > Next;
+		size_t                Done;
+		size_t                Active;
+		std::exception_ptr    Error;
+	};
+
+public:
+
+	// a_Threads is the number of threads besides the caller, and 0 uses one per remaining core.
+	ThreadPool( size_t a_Threads = 0 )
+		: m_Stop( false )
+	{
+		if ( !a_Threads )
+		{
+			size_t Cores = std::thread::hardware_concurrency();
+			a_Threads = Cores > 1 ? Cores - 1 : 1;
+		}
+
+		m_Workers.reserve( a_Threads );
+
+		for ( size_t i = 0; i < a_Threads; ++i )
+		{
+			m_Workers.emplace_back( &ThreadPool::Work, this );
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard< std::mutex > Lock( m_Mutex );
+			m_Stop = true;
+		}
+
+		m_Signal.notify_all();
+
+		for ( auto& Worker : m_Workers )
+		{
+			Worker.join();
+		}
+	}
+
+	// The pool used by parallel serialization and deserialization, created on first use.
+	static ThreadPool& Shared()
+	{
+		static ThreadPool Pool;
+		return Pool;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Workers.size();
+	}
+
+	// Calls a_Task( i ) for every i below a_Count and returns once all calls have returned, rethrowing the first
+	// exception any of them threw.
+	template < typename _Task >
+	void Run( size_t a_Count, _Task&& a_Task )
+	{
+		if ( a_Count < 2 || Depth() )
+		{
+			++Depth();
+
+			for ( size_t i = 0; i < a_Count; ++i )
+			{
+				a_Task( i );
+			}
+
+			--Depth();
+			return;
+		}
+
+		Batch Current;
+		Current.Context = &a_Task;
+		Current.Invoke = []( void* a_Context, size_t a_Index ) { ( *( std::remove_reference_t< _Task >* )a_Context )( a_Index ); };
+		Current.Count = a_Count;
+		Current.Next = 0;
+		Current.Done = 0;
+		Current.Active = 0;
+
+		{
+			std::lock_guard< std::mutex > Lock( m_Mutex );
+			m_Batches.push_back( &Current );
+		}
+
+		m_Signal.notify_all();
+		size_t Done = Execute( Current );
+
+		std::unique_lock< std::mutex > Lock( m_Mutex );
+		Retire( Current );
+		Current.Done += Done;
+		m_Finished.wait( Lock, [ & ]() { return Current.Done == Current.Count && Current.Active == 0; } );
+
+		if ( Current.Error )
+		{
+			std::rethrow_exception( Current.Error );
+		}
+	}
+
+private:
+
+	ThreadPool( ThreadPool&& ) = delete;
+
+	static size_t& Depth()
+	{
+		thread_local size_t Depth = 0;
+		return Depth;
+	}
+
+	// Runs tasks of a_Batch until none are left to claim and returns how many it ran.
+	size_t Execute( Batch& a_Batch )
+	{
+		size_t Done = 0;
+		++Depth();
+
+		for ( size_t Index = a_Batch.Next++; Index < a_Batch.Count; Index = a_Batch.Next++ )
+		{
+			try
+			{
+				a_Batch.Invoke( a_Batch.Context, Index );
+			}
+			catch ( ... )
+			{
+				std::lock_guard< std::mutex > Lock( m_Mutex );
+
+				if ( !a_Batch.Error )
+				{
+					a_Batch.Error = std::current_exception();
+				}
+			}
+
+			++Done;
+		}
+
+		--Depth();
+		return Done;
+	}
+
+	// Takes an exhausted batch off the queue. Called with m_Mutex held.
+	void Retire( Batch& a_Batch )
+	{
+		auto Queued = std::find( m_Batches.begin(), m_Batches.end(), &a_Batch );
+
+		if ( Queued != m_Batches.end() )
+		{
+			m_Batches.erase( Queued );
+		}
+	}
+
+	void Work()
+	{
+		std::unique_lock< std::mutex > Lock( m_Mutex );
+
+		while ( true )
+		{
+			m_Signal.wait( Lock, [ this ]() { return m_Stop || !m_Batches.empty(); } );
+
+			if ( m_Batches.empty() )
+			{
+				return;
+			}
+
+			Batch& Current = *m_Batches.front();
+			++Current.Active;
+			Lock.unlock();
+			size_t Done = Execute( Current );
+			Lock.lock();
+			Retire( Current );
+			Current.Done += Done;
+
+			if ( --Current.Active == 0 && Current.Done == Current.Count )
+			{
+				m_Finished.notify_all();
+			}
+		}
+	}
+
+	std::vector< std::thread > m_Workers;
+	std::deque< Batch* >       m_Batches;
+	std::mutex                 m_Mutex;
+	std::condition_variable    m_Signal;
+	std::condition_variable    m_Finished;
+	bool                       m_Stop;
+};
+
+#ifdef SERIALIZATION_INSTRUMENT
+
+// Counts calls, bytes and cycles of every Serialization::Serialize and Deserialize per type, and per stream for the
+// values written or read with operator << and >> directly. Counts of a type include the values it contains.
+class Instrumentation
+{
+public:
+
+	struct Counters
+	{
+		uint64_t Calls  = 0;
+		uint64_t Bytes  = 0;
+		uint64_t Cycles = 0;
+	};
+
+	struct Record
+	{
+		const char* Direction;
+		std::string Type;
+		Counters    Values;
+	};
+
+	// The time stamp counter where there is one, nanoseconds otherwise.
+	static inline uint64_t Cycles()
+	{
+#if ( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) ) || defined( __x86_64__ ) || defined( __i386__ )
+		return __rdtsc();
+#elif defined( __aarch64__ ) && !defined( _MSC_VER )
+		uint64_t Value;
+		asm volatile( "mrs %0, cntvct_el0" : "=r"( Value ) );
+		return Value;
+#else
+		return ( uint64_t )std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+	}
+
+	// The counters of every type seen so far, most cycles first.
+	static std::vector< Record > Collect()
+	{
+		std::vector< Record > Records;
+
+		{
+			std::lock_guard< std::mutex > Lock( Registry().Mutex );
+
+			for ( const Entry& Entry : Registry().Entries )
+			{
+				Records.push_back( { Entry.Deserialize ? "deserialize" : "serialize", Entry.Type, Entry.Load() } );
+			}
+		}
+
+		std::sort( Records.begin(), Records.end(), []( const Record& a_Left, const Record& a_Right )
+		{
+			return a_Left.Values.Cycles > a_Right.Values.Cycles;
+		} );
+
+		return Records;
+	}
+
+	static void Reset()
+	{
+		std::lock_guard< std::mutex > Lock( Registry().Mutex );
+
+		for ( Entry& Entry : Registry().Entries )
+		{
+			Entry.Calls.store( 0, std::memory_order_relaxed );
+			Entry.Bytes.store( 0, std::memory_order_relaxed );
+			Entry.Cycles.store( 0, std::memory_order_relaxed );
+		}
+	}
+
+	// Writes the counters as CSV, one line per type and direction.
+	static void Dump( FILE* a_File = stdout )
+	{
+		fprintf( a_File, "direction,type,calls,bytes,cycles,cycles_per_call\n" );
+
+		for ( const Record& Record : Collect() )
+		{
+			fprintf( a_File, "%s,\"%s\",%llu,%llu,%llu,%.1f\n", Record.Direction, Record.Type.c_str(),
+				( unsigned long long )Record.Values.Calls, ( unsigned long long )Record.Values.Bytes,
+				( unsigned long long )Record.Values.Cycles,
+				Record.Values.Calls ? ( double )Record.Values.Cycles / Record.Values.Calls : 0.0 );
+		}
+	}
+
+	template < typename T >
+	static std::string TypeName()
+	{
+		std::string Signature = _Signature< T >();
+
+#ifdef _MSC_VER
+		size_t Begin = Signature.find( "_Signature<" ) + 11;
+		size_t End = Signature.rfind( ">(" );
+#else
+		size_t Begin = Signature.find( "T = " ) + 4;
+		size_t End = Signature.find_first_of( ";]", Begin );
+#endif
+
+		return Signature.substr( Begin, End - Begin );
+	}
+
+private:
+
+	friend class Serialization;
+
+	struct Entry
+	{
+		Entry( std::string a_Type, bool a_Deserialize )
+			: Type( std::move( a_Type ) )
+			, Deserialize( a_Deserialize )
+			, Calls( 0 )
+			, Bytes( 0 )
+			, Cycles( 0 )
+		{ }
+
+		inline Counters Load() const
+		{
+			return { Calls.load( std::memory_order_relaxed ), Bytes.load( std::memory_order_relaxed ), Cycles.load( std::memory_order_relaxed ) };
+		}
+
+		std::string             Type;
+		bool                    Deserialize;
+		std::atomic< uint64_t > Calls;
+		std::atomic< uint64_t > Bytes;
+		std::atomic< uint64_t > Cycles;
+	};
+
+	struct _Registry
+	{
+		std::mutex          Mutex;
+		std::deque< Entry > Entries;
+	};
+
+	// Times one call and adds it to the entry of its type, and to the totals of the stream when it is not nested.
+	template < typename _Serializer >
+	class Scope
+	{
+	public:
+
+		Scope( Entry& a_Entry, _Serializer& a_Serializer )
+			: m_Entry( a_Entry )
+			, m_Serializer( a_Serializer )
+			, m_Position( a_Serializer.GetStream().Position() )
+			, m_Start( Cycles() )
+		{
+			++a_Serializer.m_Depth;
+		}
+
+		~Scope()
+		{
+			uint64_t Elapsed = Cycles() - m_Start;
+			size_t Position = m_Serializer.GetStream().Position();
+			uint64_t Bytes = Position > m_Position ? Position - m_Position : 0;
+
+			m_Entry.Calls.fetch_add( 1, std::memory_order_relaxed );
+			m_Entry.Bytes.fetch_add( Bytes, std::memory_order_relaxed );
+			m_Entry.Cycles.fetch_add( Elapsed, std::memory_order_relaxed );
+
+			if ( --m_Serializer.m_Depth == 0 )
+			{
+				m_Serializer.m_Counters.Calls += 1;
+				m_Serializer.m_Counters.Bytes += Bytes;
+				m_Serializer.m_Counters.Cycles += Elapsed;
+			}
+		}
+
+	private:
+
+		Entry&       m_Entry;
+		_Serializer& m_Serializer;
+		size_t       m_Position;
+		uint64_t     m_Start;
+	};
+
+	static _Registry& Registry()
+	{
+		static _Registry Registry;
+		return Registry;
+	}
+
+	template < typename T, bool _Deserialize >
+	static Entry& Of()
+	{
+		static Entry& Instance = Register( TypeName< T >(), _Deserialize );
+		return Instance;
+	}
+
+	static Entry& Register( std::string a_Type, bool a_Deserialize )
+	{
+		std::lock_guard< std::mutex > Lock( Registry().Mutex );
+		return Registry().Entries.emplace_back( std::move( a_Type ), a_Deserialize );
+	}
+
+	template < typename T >
+	static const char* _Signature()
+	{
+#ifdef _MSC_VER
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+};
+
+#endif
+
 class Serialization
 {
 	#pragma region HasOnBeforeSerialize
@@ -122,446 +632,5287 @@ class Serialization
 
 	#pragma endregion
 
-public:
+	#pragma region HasDefaultSerializer
 
 	template < typename T >
-	static constexpr bool HasOnBeforeSerialize = _HasOnBeforeSerialize< T >::value;
+	static constexpr auto _HasDefaultSerializerImpl( T* ) ->
+		typename std::bool_constant< Serializer< T >::IsDefault && Deserializer< T >::IsDefault >::type;
 
-	template < typename T >
-	static constexpr bool HasSerialize = _HasSerialize< T >::value;
+	template < typename >
+	static constexpr std::false_type _HasDefaultSerializerImpl( ... );
 
 	template < typename T >
-	static constexpr bool HasOnAfterSerialize = _HasOnAfterSerialize< T >::value;
+	using _HasDefaultSerializer = decltype( _HasDefaultSerializerImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasView
 
 	template < typename T >
-	static constexpr bool HasOnBeforeDeserialize = _HasOnBeforeDeserialize< T >::value;
+	static constexpr auto _HasViewImpl( T* ) ->
+		typename std::is_same< decltype( std::declval< T& >().View( size_t() ) ), const void* >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasViewImpl( ... );
 
 	template < typename T >
-	static constexpr bool HasDeserialize = _HasDeserialize< T >::value;
+	using _HasView = decltype( _HasViewImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasWrite
 
 	template < typename T >
-	static constexpr bool HasOnAfterDeserialize = _HasOnAfterDeserialize< T >::value;
+	static constexpr auto _HasWriteImpl( T* ) ->
+		typename std::is_same< decltype( std::declval< T& >().Write( std::declval< const void* >(), size_t() ) ), void >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasWriteImpl( ... );
 
 	template < typename T >
-	static constexpr bool HasSizeOf = _HasSizeOf< T >::value;
+	using _HasWrite = decltype( _HasWriteImpl< T >( 0 ) );
 
-	template < typename _Serializable, typename _Serializer >
-	inline static void Serialize( const _Serializable& a_Serializable, _Serializer& a_Serializer )
-	{
-		if constexpr ( HasOnBeforeSerialize< _Serializable > )
-		{
-			const_cast< _Serializable& >( a_Serializable ).OnBeforeSerialize();
-		}
+	#pragma endregion
 
-		if constexpr ( HasSerialize< _Serializable > )
-		{
-			a_Serializable.Serialize( a_Serializer );
-		}
-		else
-		{
-			Serializer< _Serializable >( a_Serializable ).Serialize( a_Serializer );
-		}
+	#pragma region HasFixedSizeMember
 
-		if constexpr ( HasOnAfterSerialize< _Serializable > )
-		{
-			const_cast< _Serializable& >( a_Serializable ).OnAfterSerialize();
-		}
-	}
+	template < typename T >
+	static constexpr auto _HasFixedSizeMemberImpl( T* ) ->
+		typename std::is_convertible< decltype( T::FixedSize ), size_t >::type;
 
-	template < typename _Deserializable, typename _Deserializer >
-	inline static void Deserialize( _Deserializable& a_Deserializable, _Deserializer& a_Deserializer )
-	{
-		if constexpr ( HasOnBeforeDeserialize< _Deserializable > )
-		{
-			const_cast< _Deserializable& >( a_Deserializable ).OnBeforeDeserialize();
-		}
+	template < typename >
+	static constexpr std::false_type _HasFixedSizeMemberImpl( ... );
 
-		if constexpr ( HasDeserialize< _Deserializable > )
-		{
-			a_Deserializable.Deserialize( a_Deserializer );
-		}
-		else
-		{
-			Deserializer< _Deserializable >( a_Deserializable ).Deserialize( a_Deserializer );
-		}
+	template < typename T >
+	using _HasFixedSizeMember = decltype( _HasFixedSizeMemberImpl< T >( 0 ) );
 
-		if constexpr ( HasOnAfterDeserialize< _Deserializable > )
-		{
-			const_cast< _Deserializable& >( a_Deserializable ).OnAfterDeserialize();
-		}
-	}
+	#pragma endregion
 
-	template < typename _Sizeable, typename _Sizer >
-	inline static void SizeOf( const _Sizeable& a_Sizeable, _Sizer& a_Sizer )
-	{
-		if constexpr ( HasSizeOf< _Sizeable > )
-		{
-			a_Sizeable.SizeOf( a_Sizer );
-		}
-		else
-		{
-			Serializer< _Sizeable >( a_Sizeable ).SizeOf( a_Sizer );
-		}
-	}
+	#pragma region HasSchemaVersion
 
-	template < typename _Sizeable >
-	inline static size_t GetSizeOf( const _Sizeable& a_Sizeable )
-	{
-		StreamSizer Sizer;
-		SizeOf( a_Sizeable, Sizer );
-		return Sizer;
-	}
+	template < typename T >
+	static constexpr auto _HasSchemaVersionImpl( T* ) ->
+		typename std::is_convertible< decltype( T::SchemaVersion ), uint64_t >::type;
 
-private:
+	template < typename >
+	static constexpr std::false_type _HasSchemaVersionImpl( ... );
 
-	Serialization( Serialization&& ) = delete;
-};
+	template < typename T >
+	using _HasSchemaVersion = decltype( _HasSchemaVersionImpl< T >( 0 ) );
 
-template < typename _Stream >
-class StreamSerializer
-{
-	typedef _Stream                     _Base;
-	typedef StreamSerializer< _Stream > _This;
+	#pragma endregion
 
-public:
+	#pragma region HasSchemaHashMember
+
+	template < typename T >
+	static constexpr auto _HasSchemaHashMemberImpl( T* ) ->
+		typename std::is_same< decltype( T::SchemaHash() ), uint64_t >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasSchemaHashMemberImpl( ... );
+
+	template < typename T >
+	using _HasSchemaHashMember = decltype( _HasSchemaHashMemberImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasSerializerSchemaHash
+
+	template < typename T >
+	static constexpr auto _HasSerializerSchemaHashImpl( T* ) ->
+		typename std::is_same< decltype( Serializer< T >::SchemaHash() ), uint64_t >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasSerializerSchemaHashImpl( ... );
+
+	template < typename T >
+	using _HasSerializerSchemaHash = decltype( _HasSerializerSchemaHashImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasSerializerFixedSizeOf
+
+	template < typename T >
+	static constexpr auto _HasSerializerFixedSizeOfImpl( T* ) ->
+		typename std::is_same< decltype( Serializer< T >::template FixedSizeOf< SizeEncoding::Fixed >() ), size_t >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasSerializerFixedSizeOfImpl( ... );
+
+	template < typename T >
+	using _HasSerializerFixedSizeOf = decltype( _HasSerializerFixedSizeOfImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasFlush
+
+	template < typename T >
+	static constexpr auto _HasFlushImpl( T* ) ->
+		typename std::is_same< decltype( std::declval< T& >().Flush(), void() ), void >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasFlushImpl( ... );
+
+	template < typename T >
+	using _HasFlush = decltype( _HasFlushImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasRetainsWrites
+
+	template < typename T >
+	static constexpr auto _HasRetainsWritesImpl( T* ) ->
+		typename std::bool_constant< T::RetainsWrites >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasRetainsWritesImpl( ... );
+
+	template < typename T >
+	using _HasRetainsWrites = decltype( _HasRetainsWritesImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasIsDirty
+
+	template < typename T >
+	static constexpr auto _HasIsDirtyImpl( T* ) ->
+		typename std::is_convertible< decltype( std::declval< const T& >().IsDirty() ), bool >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasIsDirtyImpl( ... );
+
+	template < typename T >
+	using _HasIsDirty = decltype( _HasIsDirtyImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasEqual
+
+	template < typename T >
+	static constexpr auto _HasEqualImpl( T* ) ->
+		typename std::is_convertible< decltype( std::declval< const T& >() == std::declval< const T& >() ), bool >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasEqualImpl( ... );
+
+	template < typename T >
+	using _HasEqual = decltype( _HasEqualImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasClear
+
+	template < typename T >
+	static constexpr auto _HasClearImpl( T* ) ->
+		typename std::is_same< decltype( std::declval< T& >().clear() ), void >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasClearImpl( ... );
+
+	template < typename T >
+	using _HasClear = decltype( _HasClearImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	#pragma region HasValueType
+
+	template < typename T >
+	static constexpr auto _HasValueTypeImpl( T* ) ->
+		typename std::is_same< typename T::value_type, typename T::value_type >::type;
+
+	template < typename >
+	static constexpr std::false_type _HasValueTypeImpl( ... );
+
+	template < typename T >
+	using _HasValueType = decltype( _HasValueTypeImpl< T >( 0 ) );
+
+	#pragma endregion
+
+	template < typename T, SizeEncoding _Encoding >
+	static constexpr size_t _FixedSizeOf()
+	{
+		if constexpr ( _HasFixedSizeMember< T >::value )
+		{
+			return T::FixedSize;
+		}
+		else if constexpr ( HasSerialize< T > || HasSizeOf< T > )
+		{
+			return VariableSize;
+		}
+		else if constexpr ( _HasSerializerFixedSizeOf< T >::value )
+		{
+			return Serializer< T >::template FixedSizeOf< _Encoding >();
+		}
+		else
+		{
+			return VariableSize;
+		}
+	}
+
+	template < typename T >
+	static constexpr uint64_t _SchemaVersion()
+	{
+		if constexpr ( _HasSchemaVersion< T >::value )
+		{
+			return T::SchemaVersion;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	// The SchemaVersion of a user type, combined with its own SchemaHash() when it declares one.
+	template < typename T >
+	static constexpr uint64_t _SchemaOfMembers()
+	{
+		if constexpr ( _HasSchemaHashMember< T >::value )
+		{
+			return HashCombine( HashCombine( HashName( "members" ), T::SchemaHash() ), _SchemaVersion< T >() );
+		}
+		else
+		{
+			return _SchemaVersion< T >();
+		}
+	}
+
+#ifdef _MSC_VER
+	static uint16_t _SwapWord( uint16_t a_Value )
+	{
+		return _byteswap_ushort( a_Value );
+	}
+
+	static uint32_t _SwapWord( uint32_t a_Value )
+	{
+		return _byteswap_ulong( a_Value );
+	}
+
+	static uint64_t _SwapWord( uint64_t a_Value )
+	{
+		return _byteswap_uint64( a_Value );
+	}
+#else
+	static uint16_t _SwapWord( uint16_t a_Value )
+	{
+		return __builtin_bswap16( a_Value );
+	}
+
+	static uint32_t _SwapWord( uint32_t a_Value )
+	{
+		return __builtin_bswap32( a_Value );
+	}
+
+	static uint64_t _SwapWord( uint64_t a_Value )
+	{
+		return __builtin_bswap64( a_Value );
+	}
+#endif
+
+	// The standard containers and std::pair declare operator== for any element type, so their elements are checked as well.
+	template < typename T >
+	static constexpr bool _IsComparable( T* )
+	{
+		if constexpr ( !_HasEqual< T >::value )
+		{
+			return false;
+		}
+		else if constexpr ( _HasValueType< T >::value )
+		{
+			return _IsComparable( ( std::remove_cv_t< typename T::value_type >* )nullptr );
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	template < typename T1, typename T2 >
+	static constexpr bool _IsComparable( std::pair< T1, T2 >* )
+	{
+		return _IsComparable( ( std::remove_cv_t< T1 >* )nullptr ) && _IsComparable( ( std::remove_cv_t< T2 >* )nullptr );
+	}
+
+	template < typename T >
+	static constexpr uint64_t _SchemaHash()
+	{
+		if constexpr ( HasSerialize< T > || HasDeserialize< T > || HasSizeOf< T > )
+		{
+			return HashCombine( HashName( "object" ), _SchemaOfMembers< T >() );
+		}
+		else if constexpr ( _HasSerializerSchemaHash< T >::value )
+		{
+			return Serializer< T >::SchemaHash();
+		}
+		else if constexpr ( std::is_same_v< T, bool > || std::is_same_v< T, char > )
+		{
+			return HashCombine( HashName( std::is_same_v< T, bool > ? "bool" : "char" ), sizeof( T ) );
+		}
+		else if constexpr ( std::is_floating_point_v< T > )
+		{
+			return HashCombine( HashName( "float" ), sizeof( T ) );
+		}
+		else if constexpr ( std::is_integral_v< T > )
+		{
+			return HashCombine( HashName( std::is_signed_v< T > ? "int" : "uint" ), sizeof( T ) );
+		}
+		else if constexpr ( std::is_enum_v< T > )
+		{
+			return HashCombine( HashName( "enum" ), _SchemaHash< std::underlying_type_t< T > >() );
+		}
+		else
+		{
+			return HashCombine( HashCombine( HashName( "trivial" ), sizeof( T ) ), _SchemaOfMembers< T >() );
+		}
+	}
+
+public:
+
+	template < typename T >
+	static constexpr bool HasOnBeforeSerialize = _HasOnBeforeSerialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasSerialize = _HasSerialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasOnAfterSerialize = _HasOnAfterSerialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasOnBeforeDeserialize = _HasOnBeforeDeserialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasDeserialize = _HasDeserialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasOnAfterDeserialize = _HasOnAfterDeserialize< T >::value;
+
+	template < typename T >
+	static constexpr bool HasSizeOf = _HasSizeOf< T >::value;
+
+	template < typename T >
+	static constexpr bool HasView = _HasView< T >::value;
+
+	template < typename T >
+	static constexpr bool HasWrite = _HasWrite< T >::value;
+
+	template < typename T >
+	static constexpr bool HasDefaultSerializer = _HasDefaultSerializer< T >::value;
+
+	template < typename T >
+	static constexpr bool HasFlush = _HasFlush< T >::value;
+
+	// Streams that keep large writes by address must be flushed before a temporary buffer written to them is released.
+	template < typename T >
+	static constexpr bool RetainsWrites = _HasRetainsWrites< T >::value;
+
+	static constexpr size_t VariableSize = ~size_t( 0 );
+
+	template < typename T, SizeEncoding _Encoding = SizeEncoding::Fixed >
+	static constexpr size_t FixedSizeOf = _FixedSizeOf< std::remove_cv_t< T >, _Encoding >();
+
+	template < typename T >
+	static constexpr bool HasFixedSize = FixedSizeOf< T > != VariableSize;
+
+	template < typename T >
+	static constexpr size_t GetFixedSizeOf( SizeEncoding a_Encoding )
+	{
+		return a_Encoding == SizeEncoding::Varint ? FixedSizeOf< T, SizeEncoding::Varint > : FixedSizeOf< T, SizeEncoding::Fixed >;
+	}
+
+	template < SizeEncoding _Encoding, typename... T >
+	static constexpr size_t FixedSizeOfAll()
+	{
+		size_t Size = 0;
+
+		for ( size_t Element : { FixedSizeOf< T, _Encoding >..., size_t( 0 ) } )
+		{
+			if ( Element == VariableSize )
+			{
+				return VariableSize;
+			}
+
+			Size += Element;
+		}
+
+		return Size;
+	}
+
+	static constexpr uint64_t HashName( const char* a_Name )
+	{
+		uint64_t Hash = 14695981039346656037ull;
+
+		while ( *a_Name )
+		{
+			Hash = ( Hash ^ ( uint8_t )*a_Name++ ) * 1099511628211ull;
+		}
+
+		return Hash;
+	}
+
+	static constexpr uint64_t HashCombine( uint64_t a_Seed, uint64_t a_Value )
+	{
+		for ( int i = 0; i < 64; i += 8 )
+		{
+			a_Seed = ( a_Seed ^ ( ( a_Value >> i ) & 0xFF ) ) * 1099511628211ull;
+		}
+
+		return a_Seed;
+	}
+
+	// A structural hash of the bytes T serializes to. Containers with the same layout hash alike, types with their own
+	// Serialize or SizeOf hash to "object", and anything else written as raw memory hashes its size. Neither can see
+	// the fields of a user type, so a user type changes its hash only through an optional static constexpr
+	// SchemaVersion member, which must be bumped when its layout changes, or a static constexpr uint64_t SchemaHash()
+	// member, which can hash the field types in the order they are written with SchemaHashOf.
+	template < typename T >
+	static constexpr uint64_t SchemaHash = _SchemaHash< std::remove_cv_t< T > >();
+
+	// Hashes a list of field types, for the SchemaHash() member of a user type.
+	template < typename... T >
+	static constexpr uint64_t SchemaHashOf()
+	{
+		return SchemaHashOfAll< T... >( HashName( "fields" ) );
+	}
+
+	template < typename... T >
+	static constexpr uint64_t SchemaHashOfAll( uint64_t a_Seed )
+	{
+		a_Seed = HashCombine( a_Seed, sizeof...( T ) );
+
+		for ( uint64_t Element : { SchemaHash< T >..., uint64_t( 0 ) } )
+		{
+			a_Seed = HashCombine( a_Seed, Element );
+		}
+
+		return a_Seed;
+	}
+
+	static constexpr uint64_t SequenceSchemaHash( uint64_t a_Element, bool a_Chunked = false )
+	{
+		return HashCombine( HashName( a_Chunked ? "chunked sequence" : "sequence" ), a_Element );
+	}
+
+	template < typename T >
+	static constexpr bool HasIsDirty = _HasIsDirty< T >::value;
+
+	// Whether a_Value has to be written to a delta against a_Base: its IsDirty hook decides when it has one, otherwise
+	// it is compared with a_Base, and values that can be neither are always written.
+	template < typename T >
+	static bool IsChanged( const T& a_Value, const T& a_Base )
+	{
+		if constexpr ( HasIsDirty< T > )
+		{
+			return a_Value.IsDirty();
+		}
+		else if constexpr ( _IsComparable( ( T* )nullptr ) )
+		{
+			return !( a_Value == a_Base );
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	// Resets a value before it is deserialized in place, since container deserializers add to what is there. Containers
+	// are emptied and pairs reset member-wise so that they keep their memory, raw memory is overwritten anyway, and
+	// anything else, such as a struct holding containers, is replaced by a default constructed value.
+	template < typename T >
+	static void Clear( T& a_Value )
+	{
+		if constexpr ( _HasClear< T >::value )
+		{
+			a_Value.clear();
+		}
+		else if constexpr ( !IsTriviallySerializable< T > )
+		{
+			a_Value = T();
+		}
+	}
+
+	template < typename T1, typename T2 >
+	static void Clear( std::pair< T1, T2 >& a_Value )
+	{
+		Clear( a_Value.first );
+		Clear( a_Value.second );
+	}
+
+	// Writes only what differs between a_Value and a_Base. Vectors and deques write their changed elements, maps and sets
+	// write removed keys and changed entries, and anything else is written whole when IsChanged.
+	template < typename T, typename _Serializer >
+	inline static void SerializeDelta( const T& a_Value, const T& a_Base, _Serializer& a_Serializer );
+
+	// Applies a delta written by SerializeDelta to a_Value, which must hold the base it was taken against.
+	template < typename T, typename _Deserializer >
+	inline static void DeserializeDelta( T& a_Value, _Deserializer& a_Deserializer );
+
+	// Reads a container that was written as a _Container one element at a time, so that it can be processed with a
+	// range-for loop without loading it whole.
+	template < typename _Container, typename _Deserializer >
+	inline static ElementReader< _Container, _Deserializer > ReadElements( _Deserializer& a_Deserializer );
+
+	template < typename T >
+	static constexpr bool IsTriviallySerializable =
+		std::is_trivially_copyable_v< T > &&
+		HasDefaultSerializer< T > &&
+		!HasOnBeforeSerialize< T > && !HasSerialize< T > && !HasOnAfterSerialize< T > &&
+		!HasOnBeforeDeserialize< T > && !HasDeserialize< T > && !HasOnAfterDeserialize< T > &&
+		!HasSizeOf< T >;
+
+	template < typename _Serializable, typename _Serializer >
+	inline static void Serialize( const _Serializable& a_Serializable, _Serializer& a_Serializer )
+	{
+#ifdef SERIALIZATION_INSTRUMENT
+		Instrumentation::Scope< _Serializer > Scope( Instrumentation::Of< _Serializable, false >(), a_Serializer );
+#endif
+
+		if constexpr ( HasOnBeforeSerialize< _Serializable > )
+		{
+			const_cast< _Serializable& >( a_Serializable ).OnBeforeSerialize();
+		}
+
+		if constexpr ( HasSerialize< _Serializable > )
+		{
+			a_Serializable.Serialize( a_Serializer );
+		}
+		else
+		{
+			Serializer< _Serializable >( a_Serializable ).Serialize( a_Serializer );
+		}
+
+		if constexpr ( HasOnAfterSerialize< _Serializable > )
+		{
+			const_cast< _Serializable& >( a_Serializable ).OnAfterSerialize();
+		}
+	}
+
+	template < typename _Deserializable, typename _Deserializer >
+	inline static void Deserialize( _Deserializable& a_Deserializable, _Deserializer& a_Deserializer )
+	{
+#ifdef SERIALIZATION_INSTRUMENT
+		Instrumentation::Scope< _Deserializer > Scope( Instrumentation::Of< _Deserializable, true >(), a_Deserializer );
+#endif
+
+		if constexpr ( HasOnBeforeDeserialize< _Deserializable > )
+		{
+			const_cast< _Deserializable& >( a_Deserializable ).OnBeforeDeserialize();
+		}
+
+		if constexpr ( HasDeserialize< _Deserializable > )
+		{
+			a_Deserializable.Deserialize( a_Deserializer );
+		}
+		else
+		{
+			Deserializer< _Deserializable >( a_Deserializable ).Deserialize( a_Deserializer );
+		}
+
+		if constexpr ( HasOnAfterDeserialize< _Deserializable > )
+		{
+			const_cast< _Deserializable& >( a_Deserializable ).OnAfterDeserialize();
+		}
+	}
+
+	template < typename _Sizeable, typename _Sizer >
+	inline static void SizeOf( const _Sizeable& a_Sizeable, _Sizer& a_Sizer )
+	{
+		if constexpr ( HasFixedSize< _Sizeable > )
+		{
+			a_Sizer += GetFixedSizeOf< _Sizeable >( a_Sizer.GetSizeEncoding() );
+		}
+		else if constexpr ( HasSizeOf< _Sizeable > )
+		{
+			a_Sizeable.SizeOf( a_Sizer );
+		}
+		else
+		{
+			Serializer< _Sizeable >( a_Sizeable ).SizeOf( a_Sizer );
+		}
+	}
+
+	template < typename _Sizeable >
+	inline static size_t GetSizeOf( const _Sizeable& a_Sizeable, SizeEncoding a_Encoding = SizeEncoding::Fixed, size_t a_ChunkSize = 0 );
+
+	// Default-constructs a T that allocates from a_Allocator when T is allocator-aware, so that temporaries built while
+	// loading a container come from the same resource as the container and can be moved into it without a copy.
+	template < typename T, typename _Allocator >
+	static T Construct( const _Allocator& a_Allocator )
+	{
+		if constexpr ( std::uses_allocator_v< T, _Allocator > && std::is_constructible_v< T, std::allocator_arg_t, const _Allocator& > )
+		{
+			return T( std::allocator_arg, a_Allocator );
+		}
+		else if constexpr ( std::uses_allocator_v< T, _Allocator > && std::is_constructible_v< T, const _Allocator& > )
+		{
+			return T( a_Allocator );
+		}
+		else
+		{
+			return T();
+		}
+	}
+
+	static constexpr size_t MaxChunkCount = 256;
+
+	static constexpr size_t ChunkCount( size_t a_Count, size_t a_ChunkSize )
+	{
+		return a_ChunkSize && a_Count >= a_ChunkSize ? ( a_Count / a_ChunkSize < MaxChunkCount ? a_Count / a_ChunkSize : MaxChunkCount ) : 0;
+	}
+
+	// Writes the a_Count elements starting at a_First, preceded by the chunk index when the serializer has one enabled.
+	// The elements are serialized on several threads when the serializer is parallel and the range is large enough.
+	template < typename _Serializer, typename _Iterator >
+	inline static void SerializeRange( _Serializer& a_Serializer, _Iterator a_First, size_t a_Count );
+
+	template < typename _Sizer, typename _Iterator >
+	inline static void SizeOfRange( _Sizer& a_Sizer, _Iterator a_First, size_t a_Count );
+
+	// Consumes the chunk index, if any, and returns true when the range that follows should be read with DeserializeChunks.
+	template < typename _Deserializer >
+	inline static bool ReadChunkIndex( _Deserializer& a_Deserializer, std::vector< size_t >& a_Offsets );
+
+	// Calls a_Callback( Deserializer, Begin, End ) for every chunk, concurrently, with a deserializer reading only that chunk.
+	template < typename _Deserializer, typename _Callback >
+	inline static void DeserializeChunks( _Deserializer& a_Deserializer, const std::vector< size_t >& a_Offsets, size_t a_Count, _Callback&& a_Callback );
+
+	inline static size_t EncodeVarint( uint64_t a_Value, uint8_t* a_To )
+	{
+		size_t Length = 0;
+
+		while ( a_Value >= 0x80 )
+		{
+			a_To[ Length++ ] = ( uint8_t )( a_Value | 0x80 );
+			a_Value >>= 7;
+		}
+
+		a_To[ Length++ ] = ( uint8_t )a_Value;
+		return Length;
+	}
+
+	static constexpr size_t SizeOfVarint( uint64_t a_Value )
+	{
+		size_t Length = 1;
+
+		while ( a_Value >= 0x80 )
+		{
+			a_Value >>= 7;
+			++Length;
+		}
+
+		return Length;
+	}
+
+	static constexpr size_t SizeOfSizePrefix( size_t a_Size, SizeEncoding a_Encoding )
+	{
+		return a_Encoding == SizeEncoding::Varint ? SizeOfVarint( a_Size ) : sizeof( size_t );
+	}
+
+#ifdef SERIALIZATION_BIG_ENDIAN
+	static constexpr ByteOrder HostByteOrder = ByteOrder::Big;
+#else
+	static constexpr ByteOrder HostByteOrder = ByteOrder::Little;
+#endif
+
+	static constexpr bool IsSwapped( ByteOrder a_Order )
+	{
+		return a_Order != ByteOrder::Native && a_Order != HostByteOrder;
+	}
+
+	// Only scalars have a byte order the serializer knows about; other raw types are written as they are in memory.
+	template < typename T >
+	static constexpr bool IsSwappable = ( std::is_arithmetic_v< T > || std::is_enum_v< T > ) && ( sizeof( T ) == 2 || sizeof( T ) == 4 || sizeof( T ) == 8 );
+
+	// Reverses the bytes of a_Count values of _Width bytes each. a_From and a_To may be the same buffer.
+	template < size_t _Width >
+	static void SwapBytes( const void* a_From, void* a_To, size_t a_Count )
+	{
+		static_assert( _Width == 2 || _Width == 4 || _Width == 8, "Unsupported byte swap width." );
+
+		const uint8_t* From = ( const uint8_t* )a_From;
+		uint8_t* To = ( uint8_t* )a_To;
+		size_t i = 0;
+
+#if defined( __AVX2__ )
+		uint8_t Order[ 32 ];
+
+		for ( size_t Byte = 0; Byte < 32; ++Byte )
+		{
+			Order[ Byte ] = ( uint8_t )( Byte % 16 / _Width * _Width + _Width - 1 - Byte % _Width );
+		}
+
+		const __m256i Mask = _mm256_loadu_si256( ( const __m256i* )Order );
+
+		for ( ; i + 32 / _Width <= a_Count; i += 32 / _Width )
+		{
+			__m256i Value = _mm256_loadu_si256( ( const __m256i* )( From + i * _Width ) );
+			_mm256_storeu_si256( ( __m256i* )( To + i * _Width ), _mm256_shuffle_epi8( Value, Mask ) );
+		}
+#endif
+
+#if defined( SERIALIZATION_SSE2 )
+		for ( ; i + 16 / _Width <= a_Count; i += 16 / _Width )
+		{
+			__m128i Value = _mm_loadu_si128( ( const __m128i* )( From + i * _Width ) );
+
+			if constexpr ( _Width == 4 )
+			{
+				Value = _mm_shufflehi_epi16( _mm_shufflelo_epi16( Value, 0xB1 ), 0xB1 );
+			}
+			else if constexpr ( _Width == 8 )
+			{
+				Value = _mm_shufflehi_epi16( _mm_shufflelo_epi16( Value, 0x1B ), 0x1B );
+			}
+
+			Value = _mm_or_si128( _mm_slli_epi16( Value, 8 ), _mm_srli_epi16( Value, 8 ) );
+			_mm_storeu_si128( ( __m128i* )( To + i * _Width ), Value );
+		}
+#elif defined( SERIALIZATION_NEON )
+		for ( ; i + 16 / _Width <= a_Count; i += 16 / _Width )
+		{
+			uint8x16_t Value = vld1q_u8( From + i * _Width );
+
+			if constexpr ( _Width == 2 )
+			{
+				Value = vrev16q_u8( Value );
+			}
+			else if constexpr ( _Width == 4 )
+			{
+				Value = vrev32q_u8( Value );
+			}
+			else
+			{
+				Value = vrev64q_u8( Value );
+			}
+
+			vst1q_u8( To + i * _Width, Value );
+		}
+#endif
+
+		for ( ; i < a_Count; ++i )
+		{
+			using Word = std::conditional_t< _Width == 2, uint16_t, std::conditional_t< _Width == 4, uint32_t, uint64_t > >;
+
+			Word Value;
+			memcpy( &Value, From + i * _Width, _Width );
+			Value = _SwapWord( Value );
+			memcpy( To + i * _Width, &Value, _Width );
+		}
+	}
+
+	template < typename T >
+	static T SwapValue( T a_Value )
+	{
+		SwapBytes< sizeof( T ) >( &a_Value, &a_Value, 1 );
+		return a_Value;
+	}
+
+	// Converts between host order and a_Order, in either direction.
+	template < typename T >
+	static T ToByteOrder( T a_Value, ByteOrder a_Order )
+	{
+		return IsSwapped( a_Order ) ? SwapValue( a_Value ) : a_Value;
+	}
+
+private:
+
+	Serialization( Serialization&& ) = delete;
+};
+
+struct SchemaHeader
+{
+	static constexpr uint32_t Signature = 0x5A4C5253;
+	static constexpr uint16_t CurrentVersion = 1;
+	static constexpr uint16_t VarintFlag = 1;
+	static constexpr uint16_t ChunkIndexFlag = 2;
+
+	uint32_t Tag;
+	uint16_t Version;
+	uint16_t Flags;
+	uint64_t Schema;
+
+	inline bool IsValid() const
+	{
+		return Tag == Signature && Version == CurrentVersion;
+	}
+
+	template < typename T >
+	inline bool Is() const
+	{
+		return IsValid() && Schema == Serialization::SchemaHash< T >;
+	}
+};
+
+template < typename _Stream >
+class StreamSerializer
+{
+	typedef _Stream                     _Base;
+	typedef StreamSerializer< _Stream > _This;
+
+public:
+
+	template < typename... Args >
+	StreamSerializer( Args&&... a_Args )
+		: m_ScratchSize( 0 )
+		, m_ScratchUsed( 0 )
+		, m_Stream( std::forward< Args >( a_Args )... )
+		, m_SizeEncoding( SizeEncoding::Fixed )
+		, m_ByteOrder( ByteOrder::Native )
+		, m_Swap( false )
+		, m_Parallelism( 1 )
+		, m_ParallelThreshold( DefaultParallelThreshold )
+		, m_ChunkSize( 0 )
+#ifdef SERIALIZATION_INSTRUMENT
+		, m_Depth( 0 )
+#endif
+	{ }
+
+	template < typename... Args >
+	inline void Open( Args&&... a_Args )
+	{
+		m_Stream.Open( std::forward< Args >( a_Args )... );
+	}
+
+	inline void Close()
+	{
+		m_Stream.Close();
+		m_ScratchUsed = 0;
+	}
+
+	inline _Stream& GetStream()
+	{
+		return m_Stream;
+	}
+
+	inline void SetSizeEncoding( SizeEncoding a_Encoding )
+	{
+		m_SizeEncoding = a_Encoding;
+	}
+
+	inline SizeEncoding GetSizeEncoding() const
+	{
+		return m_SizeEncoding;
+	}
+
+	// Scalars, size prefixes and arrays of scalars are written in a_Order, so files written with ByteOrder::Little or
+	// ByteOrder::Big can be read on any host. Other raw types, such as trivially copyable structs, keep their host layout.
+	inline void SetByteOrder( ByteOrder a_Order )
+	{
+		m_ByteOrder = a_Order;
+		m_Swap = Serialization::IsSwapped( a_Order );
+	}
+
+	inline ByteOrder GetByteOrder() const
+	{
+		return m_ByteOrder;
+	}
+
+	inline bool IsSwapping() const
+	{
+		return m_Swap;
+	}
+
+	// Containers of at least a_Threshold non-trivial elements are serialized on a_Threads threads, or one per core when
+	// a_Threads is 0. The output is identical to a sequential run, but element Serialize functions must be safe to run concurrently.
+	inline void SetParallelism( size_t a_Threads, size_t a_Threshold = DefaultParallelThreshold )
+	{
+		m_Parallelism = a_Threads ? a_Threads : std::thread::hardware_concurrency();
+		m_Parallelism = m_Parallelism ? m_Parallelism : 1;
+		m_ParallelThreshold = a_Threshold;
+	}
+
+	inline size_t GetParallelism() const
+	{
+		return m_Parallelism;
+	}
+
+	inline bool IsParallel( size_t a_Count ) const
+	{
+		return m_Parallelism > 1 && a_Count >= m_ParallelThreshold;
+	}
+
+	// Large vectors, deques and maps are preceded by the byte size of each run of about a_ChunkSize elements, so that
+	// a deserializer with SetChunkIndex( true ) can read the runs in parallel. A chunk size of 0 turns the index off.
+	inline void SetChunkIndex( size_t a_ChunkSize )
+	{
+		m_ChunkSize = a_ChunkSize;
+	}
+
+	inline bool HasChunkIndex() const
+	{
+		return m_ChunkSize != 0;
+	}
+
+	inline size_t GetChunkSize() const
+	{
+		return m_ChunkSize;
+	}
+
+	inline size_t GetChunkCount( size_t a_Count ) const
+	{
+		return Serialization::ChunkCount( a_Count, m_ChunkSize );
+	}
+
+	// Writes a SchemaHeader for T that also records the size encoding and whether chunk indexes follow. The header only
+	// notices layout changes of user types that declare SchemaHash() or bump SchemaVersion, see Serialization::SchemaHash.
+	template < typename T >
+	inline void WriteHeader()
+	{
+		SchemaHeader Header;
+		Header.Tag = SchemaHeader::Signature;
+		Header.Version = SchemaHeader::CurrentVersion;
+		Header.Flags = ( m_SizeEncoding == SizeEncoding::Varint ? SchemaHeader::VarintFlag : 0 ) | ( m_ChunkSize ? SchemaHeader::ChunkIndexFlag : 0 );
+		Header.Schema = Serialization::SchemaHash< T >;
+		*this << Header.Tag << Header.Version << Header.Flags << Header.Schema;
+	}
+
+	inline void WriteSizePrefix( size_t a_Size )
+	{
+		if ( m_SizeEncoding == SizeEncoding::Varint )
+		{
+			uint8_t Buffer[ 10 ];
+			m_Stream.Write( Buffer, Serialization::EncodeVarint( a_Size, Buffer ) );
+		}
+		else
+		{
+			WriteValues( &a_Size, 1 );
+		}
+	}
+
+	template < typename T >
+	inline void WriteValues( const T* a_Values, size_t a_Count )
+	{
+		if constexpr ( Serialization::IsSwappable< T > )
+		{
+			if ( m_Swap && a_Count == 1 )
+			{
+				T Value = Serialization::SwapValue( *a_Values );
+				m_Stream.Write( &Value, sizeof( T ) );
+				return;
+			}
+
+			if ( m_Swap )
+			{
+				if constexpr ( Serialization::RetainsWrites< _Stream > )
+				{
+					if ( a_Count )
+					{
+						uint8_t* Buffer = Scratch( sizeof( T ) * a_Count );
+						Serialization::SwapBytes< sizeof( T ) >( a_Values, Buffer, a_Count );
+						m_Stream.Write( Buffer, sizeof( T ) * a_Count );
+					}
+				}
+				else
+				{
+					uint8_t Buffer[ SwapBlockSize ];
+
+					for ( size_t i = 0; i < a_Count; i += SwapBlockSize / sizeof( T ) )
+					{
+						size_t Count = a_Count - i < SwapBlockSize / sizeof( T ) ? a_Count - i : SwapBlockSize / sizeof( T );
+						Serialization::SwapBytes< sizeof( T ) >( a_Values + i, Buffer, Count );
+						m_Stream.Write( Buffer, sizeof( T ) * Count );
+					}
+				}
+
+				return;
+			}
+		}
+
+		m_Stream.Write( a_Values, sizeof( T ) * a_Count );
+	}
+
+#ifdef SERIALIZATION_INSTRUMENT
+	// Totals of the values written through this stream, not counting the values they contain twice.
+	inline const Instrumentation::Counters& GetCounters() const
+	{
+		return m_Counters;
+	}
+
+	inline void ResetCounters()
+	{
+		m_Counters = Instrumentation::Counters();
+	}
+#endif
+
+	template < typename T >
+	_This& operator << ( const T& a_Serializable )
+	{
+		Serialization::Serialize( a_Serializable, *this );
+		return *this;
+	}
+
+private:
+
+	template < typename > friend class Serializer;
+
+	static constexpr size_t DefaultParallelThreshold = 16384;
+	static constexpr size_t SwapBlockSize = 4096;
+	static constexpr size_t ScratchSize = 65536;
+
+	StreamSerializer( StreamSerializer&& ) = delete;
+
+	// A stream that retains writes may keep the address of a swapped copy until it flushes, so copies are appended to
+	// the scratch buffer and the stream is only flushed when the buffer has to be reused.
+	inline uint8_t* Scratch( size_t a_Size )
+	{
+		if ( m_ScratchUsed + a_Size > m_ScratchSize )
+		{
+			if ( m_ScratchUsed )
+			{
+				m_Stream.Flush();
+				m_ScratchUsed = 0;
+			}
+
+			if ( a_Size > m_ScratchSize )
+			{
+				m_ScratchSize = a_Size > ScratchSize ? a_Size : ScratchSize;
+				m_Scratch.reset( new uint8_t[ m_ScratchSize ] );
+			}
+		}
+
+		uint8_t* Buffer = m_Scratch.get() + m_ScratchUsed;
+		m_ScratchUsed += a_Size;
+		return Buffer;
+	}
+
+	// Declared before m_Stream, which may still read retained swapped writes when it is destroyed.
+	std::unique_ptr< uint8_t[] > m_Scratch;
+	size_t                       m_ScratchSize;
+	size_t                       m_ScratchUsed;
+
+	_Stream      m_Stream;
+	SizeEncoding m_SizeEncoding;
+	ByteOrder    m_ByteOrder;
+	bool         m_Swap;
+	size_t       m_Parallelism;
+	size_t       m_ParallelThreshold;
+	size_t       m_ChunkSize;
+#ifdef SERIALIZATION_INSTRUMENT
+	friend class Instrumentation;
+
+	Instrumentation::Counters m_Counters;
+	size_t                    m_Depth;
+#endif
+};
+
+template < typename _Stream >
+class StreamDeserializer
+{
+	typedef _Stream                       _Base;
+	typedef StreamDeserializer< _Stream > _This;
+
+public:
+
+	template < typename... Args >
+	StreamDeserializer( Args&&... a_Args )
+		: m_Stream( std::forward< Args >( a_Args )... )
+		, m_SizeEncoding( SizeEncoding::Fixed )
+		, m_ByteOrder( ByteOrder::Native )
+		, m_Swap( false )
+		, m_Parallelism( 1 )
+		, m_ChunkIndex( false )
+#ifdef SERIALIZATION_INSTRUMENT
+		, m_Depth( 0 )
+#endif
+	{ }
+
+	template < typename... Args >
+	inline void Open( Args&&... a_Args )
+	{
+		m_Stream.Open( std::forward< Args >( a_Args )... );
+	}
+
+	inline void Close()
+	{
+		m_Stream.Close();
+	}
+
+	inline _Stream& GetStream()
+	{
+		return m_Stream;
+	}
+
+	inline void SetSizeEncoding( SizeEncoding a_Encoding )
+	{
+		m_SizeEncoding = a_Encoding;
+	}
+
+	inline SizeEncoding GetSizeEncoding() const
+	{
+		return m_SizeEncoding;
+	}
+
+	// Must match the byte order the data was written in.
+	inline void SetByteOrder( ByteOrder a_Order )
+	{
+		m_ByteOrder = a_Order;
+		m_Swap = Serialization::IsSwapped( a_Order );
+	}
+
+	inline ByteOrder GetByteOrder() const
+	{
+		return m_ByteOrder;
+	}
+
+	inline bool IsSwapping() const
+	{
+		return m_Swap;
+	}
+
+	// Chunked ranges are read on a_Threads threads, or one per core when a_Threads is 0.
+	inline void SetParallelism( size_t a_Threads )
+	{
+		m_Parallelism = a_Threads ? a_Threads : std::thread::hardware_concurrency();
+		m_Parallelism = m_Parallelism ? m_Parallelism : 1;
+	}
+
+	inline size_t GetParallelism() const
+	{
+		return m_Parallelism;
+	}
+
+	// Must match whether the data was written with a chunk index.
+	inline void SetChunkIndex( bool a_Enabled )
+	{
+		m_ChunkIndex = a_Enabled;
+	}
+
+	inline bool HasChunkIndex() const
+	{
+		return m_ChunkIndex;
+	}
+
+	// Reads a SchemaHeader and, when it is valid, adopts the byte order, size encoding and chunk index setting it records.
+	inline SchemaHeader ReadHeader()
+	{
+		SchemaHeader Header = {};
+		m_Stream.Read( &Header, sizeof( SchemaHeader ) );
+		AdoptByteOrder( Header.Tag, SchemaHeader::Signature );
+
+		if ( m_Swap )
+		{
+			Header.Tag = Serialization::SwapValue( Header.Tag );
+			Header.Version = Serialization::SwapValue( Header.Version );
+			Header.Flags = Serialization::SwapValue( Header.Flags );
+			Header.Schema = Serialization::SwapValue( Header.Schema );
+		}
+
+		if ( Header.IsValid() )
+		{
+			m_SizeEncoding = Header.Flags & SchemaHeader::VarintFlag ? SizeEncoding::Varint : SizeEncoding::Fixed;
+			m_ChunkIndex = ( Header.Flags & SchemaHeader::ChunkIndexFlag ) != 0;
+		}
+
+		return Header;
+	}
+
+	inline size_t ReadSizePrefix()
+	{
+		if ( m_SizeEncoding == SizeEncoding::Varint )
+		{
+			uint64_t Value = 0;
+
+			for ( int Shift = 0; Shift < 64; Shift += 7 )
+			{
+				uint8_t Byte;
+				m_Stream.Read( &Byte, 1 );
+				Value |= ( uint64_t )( Byte & 0x7F ) << Shift;
+
+				if ( !( Byte & 0x80 ) )
+				{
+					break;
+				}
+			}
+
+			return ( size_t )Value;
+		}
+
+		size_t Size;
+		ReadValues( &Size, 1 );
+		return Size;
+	}
+
+	template < typename T >
+	inline void ReadValues( T* a_Values, size_t a_Count )
+	{
+		m_Stream.Read( a_Values, sizeof( T ) * a_Count );
+
+		if constexpr ( Serialization::IsSwappable< T > )
+		{
+			if ( m_Swap )
+			{
+				Serialization::SwapBytes< sizeof( T ) >( a_Values, a_Values, a_Count );
+			}
+		}
+	}
+
+	// Switches to the byte order a_Tag was written in when it is a_Signature in either order.
+	inline void AdoptByteOrder( uint32_t a_Tag, uint32_t a_Signature )
+	{
+		if ( a_Tag == a_Signature )
+		{
+			SetByteOrder( Serialization::HostByteOrder );
+		}
+		else if ( a_Tag == Serialization::SwapValue( a_Signature ) )
+		{
+			SetByteOrder( Serialization::HostByteOrder == ByteOrder::Little ? ByteOrder::Big : ByteOrder::Little );
+		}
+	}
+
+#ifdef SERIALIZATION_INSTRUMENT
+	// Totals of the values read through this stream, not counting the values they contain twice.
+	inline const Instrumentation::Counters& GetCounters() const
+	{
+		return m_Counters;
+	}
+
+	inline void ResetCounters()
+	{
+		m_Counters = Instrumentation::Counters();
+	}
+#endif
+
+	template < typename T >
+	_This& operator >> ( T& a_Deserializable )
+	{
+		Serialization::Deserialize( a_Deserializable, *this );
+		return *this;
+	}
+
+private:
+
+	template < typename > friend class Deserializer;
+
+	StreamDeserializer( StreamDeserializer&& ) = delete;
+
+	_Stream      m_Stream;
+	SizeEncoding m_SizeEncoding;
+	ByteOrder    m_ByteOrder;
+	bool         m_Swap;
+	size_t       m_Parallelism;
+	bool         m_ChunkIndex;
+#ifdef SERIALIZATION_INSTRUMENT
+	friend class Instrumentation;
+
+	Instrumentation::Counters m_Counters;
+	size_t                    m_Depth;
+#endif
+};
+
+class StreamSizer
+{
+public:
+
+	StreamSizer( SizeEncoding a_Encoding = SizeEncoding::Fixed, size_t a_ChunkSize = 0 )
+		: m_Size( 0 )
+		, m_SizeEncoding( a_Encoding )
+		, m_ChunkSize( a_ChunkSize )
+	{ }
+
+	template < typename T >
+	StreamSizer& operator &( const T& a_Object )
+	{
+		Serialization::SizeOf( a_Object, *this );
+		return *this;
+	}
+
+	StreamSizer& operator +=( size_t a_Size )
+	{
+		m_Size += a_Size;
+		return *this;
+	}
+
+	inline void AddSizePrefix( size_t a_Size )
+	{
+		m_Size += Serialization::SizeOfSizePrefix( a_Size, m_SizeEncoding );
+	}
+
+	inline SizeEncoding GetSizeEncoding() const
+	{
+		return m_SizeEncoding;
+	}
+
+	inline bool HasChunkIndex() const
+	{
+		return m_ChunkSize != 0;
+	}
+
+	inline size_t GetChunkSize() const
+	{
+		return m_ChunkSize;
+	}
+
+	inline size_t GetChunkCount( size_t a_Count ) const
+	{
+		return Serialization::ChunkCount( a_Count, m_ChunkSize );
+	}
+
+	operator size_t () const
+	{
+		return m_Size;
+	}
+
+private:
+
+	size_t       m_Size;
+	SizeEncoding m_SizeEncoding;
+	size_t       m_ChunkSize;
+};
+
+template < typename _Sizeable >
+inline size_t Serialization::GetSizeOf( const _Sizeable& a_Sizeable, SizeEncoding a_Encoding, size_t a_ChunkSize )
+{
+	StreamSizer Sizer( a_Encoding, a_ChunkSize );
+	SizeOf( a_Sizeable, Sizer );
+	return Sizer;
+}
+
+template < typename T >
+class Serializer
+{
+	using Type = T;
+
+public:
+
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{ }
+
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{ }
+
+private:
+
+	friend class Serialization;
+
+	static constexpr bool IsDefault = true;
+
+	template < SizeEncoding _Encoding >
+	static constexpr size_t FixedSizeOf()
+	{
+		return sizeof( Type );
+	}
+
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
+	{
+		a_Serializer.WriteValues( m_Serializable, 1 );
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer += sizeof( T );
+	}
+
+	const Type* m_Serializable;
+};
+
+template < typename T >
+class Deserializer
+{
+	using Type = T;
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{ }
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{ }
+
+private:
+
+	friend class Serialization;
+
+	static constexpr bool IsDefault = true;
+
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		a_Deserializer.ReadValues( m_Deserializable, 1 );
+	}
+
+	Type* m_Deserializable;
+};
+
+class FileStream
+{
+public:
+
+	FileStream()
+#ifdef _WIN32
+		: m_File( nullptr )
+#else
+		: m_File( -1 )
+		, m_Position( 0 )
+#endif
+	{ }
+
+	FileStream( const char* a_Path )
+		: FileStream()
+	{
+		Open( a_Path );
+	}
+
+	~FileStream()
+	{
+		Close();
+	}
+
+	inline void Open( const char* a_Path )
+	{
+		if ( IsOpen() )
+		{
+			Close();
+		}
+
+#ifdef _WIN32
+		fopen_s( &m_File, a_Path, "rb+" );
+#else
+		m_File = open( a_Path, O_RDWR );
+		m_Position = 0;
+#endif
+
+		SERIALIZATION_ASSERT( IsOpen(), "File does not exist." );
+	}
+
+	inline void Close()
+	{
+		if ( !IsOpen() )
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		fclose( m_File );
+		m_File = nullptr;
+#else
+		::close( m_File );
+		m_File = -1;
+#endif
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+#ifdef _WIN32
+		fwrite( a_From, 1, a_Size, m_File );
+#else
+		const uint8_t* From = ( const uint8_t* )a_From;
+
+		while ( a_Size )
+		{
+			ssize_t Written = pwrite( m_File, From, a_Size, ( off_t )m_Position );
+
+			if ( Written <= 0 )
+			{
+				if ( Written < 0 && errno == EINTR )
+				{
+					continue;
+				}
+
+				break;
+			}
+
+			From += Written;
+			a_Size -= ( size_t )Written;
+			m_Position += ( size_t )Written;
+		}
+#endif
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+#ifdef _WIN32
+		fread( a_To, 1, a_Size, m_File );
+#else
+		uint8_t* To = ( uint8_t* )a_To;
+
+		while ( a_Size )
+		{
+			ssize_t Read = pread( m_File, To, a_Size, ( off_t )m_Position );
+
+			if ( Read <= 0 )
+			{
+				if ( Read < 0 && errno == EINTR )
+				{
+					continue;
+				}
+
+				break;
+			}
+
+			To += Read;
+			a_Size -= ( size_t )Read;
+			m_Position += ( size_t )Read;
+		}
+#endif
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+#ifdef _WIN32
+		fseek( m_File, a_Position, SEEK_SET );
+#else
+		m_Position = a_Position;
+#endif
+	}
+
+	inline size_t Position() const
+	{
+#ifdef _WIN32
+		return ( size_t )ftell( m_File );
+#else
+		return m_Position;
+#endif
+	}
+
+	inline void Flush()
+	{
+#ifdef _WIN32
+		fflush( m_File );
+#endif
+	}
+
+	inline bool End() const
+	{
+#ifdef _WIN32
+		return feof( m_File );
+#else
+		return m_Position >= Size();
+#endif
+	}
+
+	inline size_t Size() const
+	{
+		if ( !IsOpen() )
+		{
+			return 0;
+		}
+
+#ifdef _WIN32
+		size_t Position = ftell( m_File );
+		fseek( m_File, 0, SEEK_END );
+		size_t Size = ftell( m_File );
+		fseek( m_File, Position, SEEK_SET );
+		return Size;
+#else
+		struct stat Stat;
+		fstat( m_File, &Stat );
+		return ( size_t )Stat.st_size;
+#endif
+	}
+
+	inline bool IsOpen() const
+	{
+#ifdef _WIN32
+		return m_File != nullptr;
+#else
+		return m_File != -1;
+#endif
+	}
+
+#ifdef _WIN32
+	inline FILE* NativeHandle() const
+#else
+	inline int NativeHandle() const
+#endif
+	{
+		return m_File;
+	}
+
+private:
+
+	template < typename > friend class Serializer;
+	template < typename > friend class Deserializer;
+
+#ifdef _WIN32
+	FILE*  m_File;
+#else
+	int    m_File;
+	size_t m_Position;
+#endif
+};
+
+class BufferStream
+{
+public:
+
+	enum class Growth
+	{
+		Fixed,
+		Geometric
+	};
+
+	BufferStream()
+		: m_Data( nullptr )
+		, m_Head( nullptr )
+		, m_Size( 0 )
+		, m_Capacity( 0 )
+		, m_FixedSize( 0 )
+		, m_Growth( Growth::Geometric )
+	{ }
+
+	BufferStream( size_t a_Size, Growth a_Growth = Growth::Fixed )
+		: m_Data( nullptr )
+		, m_Head( nullptr )
+		, m_Size( 0 )
+		, m_Capacity( 0 )
+		, m_FixedSize( 0 )
+		, m_Growth( a_Growth )
+	{
+		Open( a_Size, a_Growth );
+	}
+
+	~BufferStream()
+	{
+		Close();
+	}
+
+	void Open()
+	{
+		Open( 0, Growth::Geometric );
+	}
+
+	// Reopening keeps the memory already allocated, but a fixed buffer still only holds a_Size bytes.
+	void Open( size_t a_Size, Growth a_Growth = Growth::Fixed )
+	{
+		m_Growth = a_Growth;
+		m_Head = m_Data;
+		Reserve( a_Size );
+		m_FixedSize = m_Growth == Growth::Fixed ? a_Size : 0;
+		m_Size = m_FixedSize;
+	}
+
+	void Close()
+	{
+		free( m_Data );
+		m_Data = nullptr;
+		m_Head = nullptr;
+		m_Size = 0;
+		m_Capacity = 0;
+		m_FixedSize = 0;
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		if ( a_Size == 0 )
+		{
+			return;
+		}
+
+		size_t Position = m_Head - m_Data;
+
+		if ( m_Growth == Growth::Fixed )
+		{
+			SERIALIZATION_CHECK( Position + a_Size <= m_FixedSize, "Write exceeds the size of a fixed buffer." );
+		}
+		else if ( Position + a_Size > m_Capacity )
+		{
+			Grow( Position + a_Size );
+		}
+
+		memcpy( m_Head, a_From, a_Size );
+		m_Head += a_Size;
+
+		if ( Position + a_Size > m_Size )
+		{
+			m_Size = Position + a_Size;
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		memcpy( a_To, m_Head, a_Size );
+		m_Head += a_Size;
+	}
+
+	inline const void* View( size_t a_Size )
+	{
+		const uint8_t* Head = m_Head;
+		m_Head += a_Size;
+		return Head;
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		if ( m_Growth == Growth::Fixed )
+		{
+			SERIALIZATION_CHECK( a_Position <= m_FixedSize, "Seek exceeds the size of a fixed buffer." );
+		}
+		else if ( a_Position > m_Capacity )
+		{
+			Grow( a_Position );
+		}
+
+		m_Head = m_Data + a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return ( size_t )( m_Head - m_Data );
+	}
+
+	inline bool End() const
+	{
+		return ( size_t )( m_Head - m_Data ) == m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+	inline size_t Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	inline const uint8_t* Data() const
+	{
+		return m_Data;
+	}
+
+	inline uint8_t* Data()
+	{
+		return m_Data;
+	}
+
+	void Reserve( size_t a_Capacity )
+	{
+		if ( a_Capacity > m_Capacity )
+		{
+			Reallocate( a_Capacity );
+		}
+	}
+
+	void Shrink()
+	{
+		if ( m_Size < m_Capacity )
+		{
+			Reallocate( m_Size );
+		}
+	}
+
+	// Empties the buffer but keeps its memory, so that it can be refilled without allocating.
+	void Reset()
+	{
+		m_Head = m_Data;
+		m_Size = m_FixedSize;
+	}
+
+	uint8_t* Release()
+	{
+		uint8_t* Data = m_Data;
+		m_Data = nullptr;
+		m_Head = nullptr;
+		m_Size = 0;
+		m_Capacity = 0;
+		m_FixedSize = 0;
+		return Data;
+	}
+
+private:
+
+	void Grow( size_t a_Required )
+	{
+		size_t Capacity = m_Capacity ? m_Capacity : 64;
+
+		while ( Capacity < a_Required )
+		{
+			Capacity += Capacity;
+		}
+
+		Reallocate( Capacity );
+	}
+
+	void Reallocate( size_t a_Capacity )
+	{
+		size_t Position = m_Head - m_Data;
+		Position = Position > a_Capacity ? a_Capacity : Position;
+
+		if ( a_Capacity == 0 )
+		{
+			free( m_Data );
+			m_Data = nullptr;
+		}
+		else
+		{
+			uint8_t* Data = ( uint8_t* )realloc( m_Data, a_Capacity );
+
+			if ( !Data )
+			{
+				throw std::bad_alloc();
+			}
+
+			m_Data = Data;
+		}
+
+		m_Head = m_Data + Position;
+		m_Capacity = a_Capacity;
+	}
+
+	uint8_t* m_Data;
+	uint8_t* m_Head;
+	size_t   m_Size;
+	size_t   m_Capacity;
+	size_t   m_FixedSize;
+	Growth   m_Growth;
+};
+
+class ViewStream
+{
+public:
+
+	ViewStream()
+		: m_Data( nullptr )
+		, m_Head( nullptr )
+		, m_Size( 0 )
+	{ }
+
+	ViewStream( const void* a_Data, size_t a_Size )
+		: ViewStream()
+	{
+		Open( a_Data, a_Size );
+	}
+
+	void Open( const void* a_Data, size_t a_Size )
+	{
+		m_Data = ( const uint8_t* )a_Data;
+		m_Head = m_Data;
+		m_Size = a_Size;
+	}
+
+	void Close()
+	{
+		m_Data = nullptr;
+		m_Head = nullptr;
+		m_Size = 0;
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		if ( a_Size == 0 )
+		{
+			return;
+		}
+
+		memcpy( a_To, m_Head, a_Size );
+		m_Head += a_Size;
+	}
+
+	inline const void* View( size_t a_Size )
+	{
+		const uint8_t* Head = m_Head;
+		m_Head += a_Size;
+		return Head;
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		m_Head = m_Data + a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return ( size_t )( m_Head - m_Data );
+	}
+
+	inline bool End() const
+	{
+		return m_Head >= m_Data + m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+	inline const uint8_t* Data() const
+	{
+		return m_Data;
+	}
+
+private:
+
+	const uint8_t* m_Data;
+	const uint8_t* m_Head;
+	size_t         m_Size;
+};
+
+template < typename _Serializer, typename _Iterator >
+inline void Serialization::SerializeRange( _Serializer& a_Serializer, _Iterator a_First, size_t a_Count )
+{
+	size_t Chunks = a_Serializer.GetChunkCount( a_Count );
+
+	if ( a_Serializer.HasChunkIndex() )
+	{
+		a_Serializer.WriteSizePrefix( Chunks );
+	}
+
+	if ( !a_Serializer.IsParallel( a_Count ) )
+	{
+		if ( Chunks )
+		{
+			_Iterator Iterator = a_First;
+
+			for ( size_t Chunk = 0; Chunk < Chunks; ++Chunk )
+			{
+				StreamSizer Sizer( a_Serializer.GetSizeEncoding(), a_Serializer.GetChunkSize() );
+
+				for ( size_t i = a_Count * Chunk / Chunks; i < a_Count * ( Chunk + 1 ) / Chunks; ++i, ++Iterator )
+				{
+					Sizer & *Iterator;
+				}
+
+				a_Serializer.WriteSizePrefix( Sizer );
+			}
+		}
+
+		for ( size_t i = 0; i < a_Count; ++i, ++a_First )
+		{
+			a_Serializer << *a_First;
+		}
+
+		return;
+	}
+
+	size_t Count = Chunks ? Chunks : a_Serializer.GetParallelism();
+	Count = Count < a_Count ? Count : a_Count;
+	size_t Threads = a_Serializer.GetParallelism() < Count ? a_Serializer.GetParallelism() : Count;
+	std::unique_ptr< StreamSerializer< BufferStream >[] > Parts( new StreamSerializer< BufferStream >[ Count ] );
+	std::vector< _Iterator > Bounds;
+	Bounds.reserve( Count + 1 );
+	Bounds.push_back( a_First );
+
+	for ( size_t i = 1; i <= Count; ++i )
+	{
+		Bounds.push_back( std::next( Bounds.back(), a_Count * i / Count - a_Count * ( i - 1 ) / Count ) );
+	}
+
+	auto Work = [ & ]( size_t a_Thread )
+	{
+		for ( size_t Index = a_Thread; Index < Count; Index += Threads )
+		{
+			StreamSerializer< BufferStream >& Part = Parts[ Index ];
+			StreamSizer Sizer( a_Serializer.GetSizeEncoding(), a_Serializer.GetChunkSize() );
+
+			for ( _Iterator Iterator = Bounds[ Index ]; Iterator != Bounds[ Index + 1 ]; ++Iterator )
+			{
+				Sizer & *Iterator;
+			}
+
+			Part.SetSizeEncoding( a_Serializer.GetSizeEncoding() );
+			Part.SetByteOrder( a_Serializer.GetByteOrder() );
+			Part.SetChunkIndex( a_Serializer.GetChunkSize() );
+			Part.GetStream().Reserve( Sizer );
+
+			for ( _Iterator Iterator = Bounds[ Index ]; Iterator != Bounds[ Index + 1 ]; ++Iterator )
+			{
+				Part << *Iterator;
+			}
+		}
+	};
+
+	ThreadPool::Shared().Run( Threads, Work );
+
+	if ( Chunks )
+	{
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			a_Serializer.WriteSizePrefix( Parts[ i ].GetStream().Size() );
+		}
+	}
+
+	for ( size_t i = 0; i < Count; ++i )
+	{
+		a_Serializer.GetStream().Write( Parts[ i ].GetStream().Data(), Parts[ i ].GetStream().Size() );
+	}
+
+	if constexpr ( RetainsWrites< std::remove_reference_t< decltype( a_Serializer.GetStream() ) > > )
+	{
+		a_Serializer.GetStream().Flush();
+	}
+}
+
+template < typename _Sizer, typename _Iterator >
+inline void Serialization::SizeOfRange( _Sizer& a_Sizer, _Iterator a_First, size_t a_Count )
+{
+	using Element = typename std::iterator_traits< _Iterator >::value_type;
+
+	size_t Chunks = a_Sizer.GetChunkCount( a_Count );
+
+	if ( a_Sizer.HasChunkIndex() )
+	{
+		a_Sizer.AddSizePrefix( Chunks );
+	}
+
+	if constexpr ( HasFixedSize< Element > )
+	{
+		size_t Size = GetFixedSizeOf< Element >( a_Sizer.GetSizeEncoding() );
+
+		for ( size_t Chunk = 0; Chunk < Chunks; ++Chunk )
+		{
+			a_Sizer.AddSizePrefix( ( a_Count * ( Chunk + 1 ) / Chunks - a_Count * Chunk / Chunks ) * Size );
+		}
+
+		a_Sizer += a_Count * Size;
+	}
+	else if ( Chunks )
+	{
+		for ( size_t Chunk = 0; Chunk < Chunks; ++Chunk )
+		{
+			StreamSizer Sizer( a_Sizer.GetSizeEncoding(), a_Sizer.GetChunkSize() );
+
+			for ( size_t i = a_Count * Chunk / Chunks; i < a_Count * ( Chunk + 1 ) / Chunks; ++i, ++a_First )
+			{
+				Sizer & *a_First;
+			}
+
+			a_Sizer.AddSizePrefix( Sizer );
+			a_Sizer += Sizer;
+		}
+	}
+	else
+	{
+		for ( size_t i = 0; i < a_Count; ++i, ++a_First )
+		{
+			a_Sizer & *a_First;
+		}
+	}
+}
+
+template < typename _Deserializer >
+inline bool Serialization::ReadChunkIndex( _Deserializer& a_Deserializer, std::vector< size_t >& a_Offsets )
+{
+	if ( !a_Deserializer.HasChunkIndex() )
+	{
+		return false;
+	}
+
+	size_t Chunks = a_Deserializer.ReadSizePrefix();
+
+	if ( !Chunks )
+	{
+		return false;
+	}
+
+	a_Offsets.resize( Chunks + 1 );
+	a_Offsets[ 0 ] = 0;
+
+	for ( size_t i = 0; i < Chunks; ++i )
+	{
+		a_Offsets[ i + 1 ] = a_Offsets[ i ] + a_Deserializer.ReadSizePrefix();
+	}
+
+	return a_Deserializer.GetParallelism() > 1;
+}
+
+template < typename _Deserializer, typename _Callback >
+inline void Serialization::DeserializeChunks( _Deserializer& a_Deserializer, const std::vector< size_t >& a_Offsets, size_t a_Count, _Callback&& a_Callback )
+{
+	size_t Chunks = a_Offsets.size() - 1;
+	size_t Threads = a_Deserializer.GetParallelism() < Chunks ? a_Deserializer.GetParallelism() : Chunks;
+	std::unique_ptr< uint8_t[] > Copy;
+	const uint8_t* Data;
+
+	if constexpr ( HasView< std::remove_reference_t< decltype( a_Deserializer.GetStream() ) > > )
+	{
+		Data = ( const uint8_t* )a_Deserializer.GetStream().View( a_Offsets.back() );
+	}
+	else
+	{
+		Copy.reset( new uint8_t[ a_Offsets.back() ] );
+		a_Deserializer.GetStream().Read( Copy.get(), a_Offsets.back() );
+		Data = Copy.get();
+	}
+
+	auto Work = [ & ]( size_t a_Thread )
+	{
+		for ( size_t Chunk = a_Thread; Chunk < Chunks; Chunk += Threads )
+		{
+			StreamDeserializer< ViewStream > Part( Data + a_Offsets[ Chunk ], a_Offsets[ Chunk + 1 ] - a_Offsets[ Chunk ] );
+			Part.SetSizeEncoding( a_Deserializer.GetSizeEncoding() );
+			Part.SetByteOrder( a_Deserializer.GetByteOrder() );
+			Part.SetChunkIndex( true );
+			a_Callback( Part, a_Count * Chunk / Chunks, a_Count * ( Chunk + 1 ) / Chunks );
+		}
+	};
+
+	ThreadPool::Shared().Run( Threads, Work );
+}
+
+class MMapStream
+{
+public:
+
+	MMapStream()
+		: m_Data( nullptr )
+		, m_Head( nullptr )
+		, m_Size( 0 )
+		, m_Capacity( 0 )
+#ifdef _WIN32
+		, m_File( INVALID_HANDLE_VALUE )
+		, m_Mapping( nullptr )
+#else
+		, m_File( -1 )
+#endif
+	{ }
+
+	MMapStream( const char* a_Path )
+		: MMapStream()
+	{
+		Open( a_Path );
+	}
+
+	~MMapStream()
+	{
+		Close();
+	}
+
+	void Open( const char* a_Path )
+	{
+		if ( IsOpen() )
+		{
+			Close();
+		}
+
+#ifdef _WIN32
+		m_File = CreateFileA( a_Path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+		SERIALIZATION_ASSERT( m_File != INVALID_HANDLE_VALUE, "File does not exist." );
+
+		LARGE_INTEGER Size;
+		GetFileSizeEx( m_File, &Size );
+		m_Size = ( size_t )Size.QuadPart;
+#else
+		m_File = open( a_Path, O_RDWR );
+		SERIALIZATION_ASSERT( m_File != -1, "File does not exist." );
+
+		struct stat Stat;
+		fstat( m_File, &Stat );
+		m_Size = ( size_t )Stat.st_size;
+#endif
+
+		m_Capacity = m_Size;
+		Map( m_Size );
+		m_Head = m_Data;
+	}
+
+	void Close()
+	{
+		if ( !IsOpen() )
+		{
+			return;
+		}
+
+		Unmap();
+
+#ifdef _WIN32
+		if ( m_Capacity != m_Size )
+		{
+			LARGE_INTEGER Size;
+			Size.QuadPart = ( LONGLONG )m_Size;
+			SetFilePointerEx( m_File, Size, nullptr, FILE_BEGIN );
+			SetEndOfFile( m_File );
+		}
+
+		CloseHandle( m_File );
+		m_File = INVALID_HANDLE_VALUE;
+#else
+		if ( m_Capacity != m_Size )
+		{
+			ftruncate( m_File, ( off_t )m_Size );
+		}
+
+		::close( m_File );
+		m_File = -1;
+#endif
+
+		m_Size = 0;
+		m_Capacity = 0;
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		size_t Position = m_Head - m_Data;
+
+		if ( Position + a_Size > m_Capacity )
+		{
+			Grow( Position + a_Size );
+		}
+
+		memcpy( m_Head, a_From, a_Size );
+		m_Head += a_Size;
+
+		if ( Position + a_Size > m_Size )
+		{
+			m_Size = Position + a_Size;
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		memcpy( a_To, m_Head, a_Size );
+		m_Head += a_Size;
+	}
+
+	inline const void* View( size_t a_Size )
+	{
+		const uint8_t* Head = m_Head;
+		m_Head += a_Size;
+		return Head;
+	}
+
+	// Only Write extends the file, so that seeking through a file that is being read never changes it.
+	inline void Seek( size_t a_Position )
+	{
+		SERIALIZATION_CHECK( a_Position <= m_Size, "Seek exceeds the end of the mapped file." );
+		m_Head = m_Data + a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return ( size_t )( m_Head - m_Data );
+	}
+
+	inline bool End() const
+	{
+		return ( size_t )( m_Head - m_Data ) == m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+	inline const uint8_t* Data() const
+	{
+		return m_Data;
+	}
+
+	inline bool IsOpen() const
+	{
+#ifdef _WIN32
+		return m_File != INVALID_HANDLE_VALUE;
+#else
+		return m_File != -1;
+#endif
+	}
+
+private:
+
+	void Grow( size_t a_Required )
+	{
+		size_t Capacity = m_Capacity > 65536 ? m_Capacity : 65536;
+
+		while ( Capacity < a_Required )
+		{
+			Capacity += Capacity;
+		}
+
+		size_t Position = m_Head - m_Data;
+		Unmap();
+
+#ifndef _WIN32
+		SERIALIZATION_CHECK( ftruncate( m_File, ( off_t )Capacity ) == 0, "Failed to extend file." );
+#endif
+
+		m_Capacity = Capacity;
+		Map( Capacity );
+		m_Head = m_Data + Position;
+	}
+
+	void Map( size_t a_Size )
+	{
+		if ( a_Size )
+		{
+#ifdef _WIN32
+			m_Mapping = CreateFileMappingA( m_File, nullptr, PAGE_READWRITE, ( DWORD )( ( uint64_t )a_Size >> 32 ), ( DWORD )a_Size, nullptr );
+			SERIALIZATION_CHECK( m_Mapping, "Failed to map file." );
+			m_Data = ( uint8_t* )MapViewOfFile( m_Mapping, FILE_MAP_ALL_ACCESS, 0, 0, a_Size );
+			SERIALIZATION_CHECK( m_Data, "Failed to map file." );
+#else
+			void* Data = mmap( nullptr, a_Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0 );
+			SERIALIZATION_CHECK( Data != MAP_FAILED, "Failed to map file." );
+			m_Data = ( uint8_t* )Data;
+#endif
+		}
+	}
+
+	void Unmap()
+	{
+		if ( m_Data )
+		{
+#ifdef _WIN32
+			UnmapViewOfFile( m_Data );
+			CloseHandle( m_Mapping );
+			m_Mapping = nullptr;
+#else
+			munmap( m_Data, m_Capacity );
+#endif
+		}
+
+		m_Data = nullptr;
+		m_Head = nullptr;
+	}
+
+	uint8_t* m_Data;
+	uint8_t* m_Head;
+	size_t   m_Size;
+	size_t   m_Capacity;
+#ifdef _WIN32
+	HANDLE   m_File;
+	HANDLE   m_Mapping;
+#else
+	int      m_File;
+#endif
+};
+
+class BufferedFileStream
+{
+public:
+
+	static constexpr size_t DefaultBlockSize = 1 << 20;
+
+	BufferedFileStream()
+		: m_Buffer( nullptr )
+		, m_BlockSize( 0 )
+		, m_Position( 0 )
+		, m_BufferStart( 0 )
+		, m_BufferLength( 0 )
+		, m_Size( 0 )
+		, m_Writing( false )
+	{ }
+
+	BufferedFileStream( const char* a_Path, size_t a_BlockSize = DefaultBlockSize )
+		: BufferedFileStream()
+	{
+		Open( a_Path, a_BlockSize );
+	}
+
+	~BufferedFileStream()
+	{
+		Close();
+	}
+
+	void Open( const char* a_Path, size_t a_BlockSize = DefaultBlockSize )
+	{
+		if ( m_Buffer )
+		{
+			Close();
+		}
+
+		m_File.Open( a_Path );
+		m_Buffer = ( uint8_t* )malloc( a_BlockSize );
+		m_BlockSize = a_BlockSize;
+		m_Position = 0;
+		m_BufferStart = 0;
+		m_BufferLength = 0;
+		m_Size = m_File.Size();
+		m_Writing = false;
+	}
+
+	void Close()
+	{
+		if ( !m_Buffer )
+		{
+			return;
+		}
+
+		Flush();
+		m_File.Close();
+		free( m_Buffer );
+		m_Buffer = nullptr;
+		m_BlockSize = 0;
+		m_Size = 0;
+	}
+
+	void Flush()
+	{
+		if ( m_Writing && m_BufferLength )
+		{
+			m_File.Seek( m_BufferStart );
+			m_File.Write( m_Buffer, m_BufferLength );
+			m_File.Flush();
+		}
+
+		m_BufferStart = m_Position;
+		m_BufferLength = 0;
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		if ( !m_Writing )
+		{
+			m_BufferStart = m_Position;
+			m_BufferLength = 0;
+			m_Writing = true;
+		}
+
+		if ( m_BufferLength + a_Size > m_BlockSize )
+		{
+			Flush();
+		}
+
+		if ( a_Size >= m_BlockSize )
+		{
+			m_File.Seek( m_Position );
+			m_File.Write( a_From, a_Size );
+			m_BufferStart = m_Position + a_Size;
+		}
+		else
+		{
+			memcpy( m_Buffer + m_BufferLength, a_From, a_Size );
+			m_BufferLength += a_Size;
+		}
+
+		m_Position += a_Size;
+
+		if ( m_Position > m_Size )
+		{
+			m_Size = m_Position;
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		if ( m_Writing )
+		{
+			Flush();
+			m_Writing = false;
+		}
+
+		uint8_t* To = ( uint8_t* )a_To;
+		size_t Available = m_BufferStart + m_BufferLength - m_Position;
+
+		if ( a_Size <= Available )
+		{
+			memcpy( To, m_Buffer + ( m_Position - m_BufferStart ), a_Size );
+			m_Position += a_Size;
+			return;
+		}
+
+		memcpy( To, m_Buffer + ( m_Position - m_BufferStart ), Available );
+		To += Available;
+		a_Size -= Available;
+		m_Position += Available;
+
+		if ( a_Size >= m_BlockSize )
+		{
+			m_File.Seek( m_Position );
+			m_File.Read( To, a_Size );
+			m_Position += a_Size;
+			m_BufferStart = m_Position;
+			m_BufferLength = 0;
+			return;
+		}
+
+		m_BufferStart = m_Position;
+		m_BufferLength = m_Size > m_Position ? m_Size - m_Position : 0;
+		m_BufferLength = m_BufferLength > m_BlockSize ? m_BlockSize : m_BufferLength;
+		m_File.Seek( m_BufferStart );
+		m_File.Read( m_Buffer, m_BufferLength );
+
+		size_t Length = a_Size > m_BufferLength ? m_BufferLength : a_Size;
+		memcpy( To, m_Buffer, Length );
+		m_Position += Length;
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		if ( m_Writing )
+		{
+			Flush();
+		}
+
+		if ( !m_Writing && a_Position >= m_BufferStart && a_Position <= m_BufferStart + m_BufferLength )
+		{
+			m_Position = a_Position;
+			return;
+		}
+
+		m_Position = a_Position;
+		m_BufferStart = a_Position;
+		m_BufferLength = 0;
+	}
+
+	inline size_t Position() const
+	{
+		return m_Position;
+	}
+
+	inline bool End() const
+	{
+		return m_Position >= m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+	inline size_t BlockSize() const
+	{
+		return m_BlockSize;
+	}
+
+private:
+
+	FileStream m_File;
+	uint8_t*   m_Buffer;
+	size_t     m_BlockSize;
+	size_t     m_Position;
+	size_t     m_BufferStart;
+	size_t     m_BufferLength;
+	size_t     m_Size;
+	bool       m_Writing;
+};
+
+// Writes of at least the threshold size are recorded by address rather than copied, so
+// their memory must stay alive and unchanged until the next Flush(), Seek(), Read() or Close().
+class GatherStream
+{
+	struct Segment
+	{
+		const uint8_t* Data;
+		size_t         Size;
+	};
+
+public:
+
+	static constexpr size_t DefaultThreshold = 16384;
+	static constexpr size_t DefaultStagingSize = 65536;
+	static constexpr size_t MaxSegments = 4096;
+	static constexpr size_t MinThreshold = 64;
+	static constexpr bool   RetainsWrites = true;
+
+	GatherStream()
+		: m_Staging( nullptr )
+		, m_StagingSize( 0 )
+		, m_StagingCapacity( 0 )
+		, m_Threshold( DefaultThreshold )
+		, m_Position( 0 )
+		, m_Pending( 0 )
+		, m_Size( 0 )
+	{ }
+
+	GatherStream( const char* a_Path, size_t a_Threshold = DefaultThreshold, size_t a_StagingSize = DefaultStagingSize )
+		: GatherStream()
+	{
+		Open( a_Path, a_Threshold, a_StagingSize );
+	}
+
+	~GatherStream()
+	{
+		Close();
+	}
+
+	// Writes below MinThreshold are always copied, because serializers write small values from temporaries.
+	void Open( const char* a_Path, size_t a_Threshold = DefaultThreshold, size_t a_StagingSize = DefaultStagingSize )
+	{
+		if ( m_File.IsOpen() )
+		{
+			Close();
+		}
+
+		a_StagingSize = a_StagingSize > MinThreshold ? a_StagingSize : MinThreshold;
+		a_Threshold = a_Threshold > MinThreshold ? a_Threshold : MinThreshold;
+
+		m_File.Open( a_Path );
+		m_Staging = ( uint8_t* )malloc( a_StagingSize );
+		m_StagingSize = 0;
+		m_StagingCapacity = a_StagingSize;
+		m_Threshold = a_Threshold < a_StagingSize ? a_Threshold : a_StagingSize;
+		m_Position = 0;
+		m_Pending = 0;
+		m_Size = m_File.Size();
+	}
+
+	void Close()
+	{
+		if ( !m_File.IsOpen() )
+		{
+			return;
+		}
+
+		Flush();
+		m_File.Close();
+		free( m_Staging );
+		m_Staging = nullptr;
+		m_StagingCapacity = 0;
+		m_Size = 0;
+	}
+
+	void Flush()
+	{
+		if ( m_Segments.empty() )
+		{
+			return;
+		}
+
+		size_t Offset = m_Position - m_Pending;
+
+#ifdef _WIN32
+		m_File.Seek( Offset );
+
+		for ( auto& Pending : m_Segments )
+		{
+			m_File.Write( Pending.Data, Pending.Size );
+		}
+#else
+		m_Vectors.resize( m_Segments.size() );
+
+		for ( size_t i = 0; i < m_Segments.size(); ++i )
+		{
+			m_Vectors[ i ].iov_base = const_cast< uint8_t* >( m_Segments[ i ].Data );
+			m_Vectors[ i ].iov_len = m_Segments[ i ].Size;
+		}
+
+		int    Handle = m_File.NativeHandle();
+		size_t Index = 0;
+		size_t Count = m_Vectors.size();
+		bool   Failed = false;
+
+#ifdef IOV_MAX
+		constexpr size_t BatchSize = IOV_MAX;
+#else
+		constexpr size_t BatchSize = 1024;
+#endif
+
+		while ( Index < Count )
+		{
+			size_t  Batch = Count - Index < BatchSize ? Count - Index : BatchSize;
+			lseek( Handle, ( off_t )Offset, SEEK_SET );
+			ssize_t Written = writev( Handle, &m_Vectors[ Index ], ( int )Batch );
+
+			if ( Written <= 0 )
+			{
+				if ( Written < 0 && errno == EINTR )
+				{
+					continue;
+				}
+
+				Failed = true;
+				break;
+			}
+
+			Offset += ( size_t )Written;
+
+			while ( Index < Count && ( size_t )Written >= m_Vectors[ Index ].iov_len )
+			{
+				Written -= ( ssize_t )m_Vectors[ Index ].iov_len;
+				++Index;
+			}
+
+			if ( Written > 0 )
+			{
+				m_Vectors[ Index ].iov_base = ( uint8_t* )m_Vectors[ Index ].iov_base + Written;
+				m_Vectors[ Index ].iov_len -= ( size_t )Written;
+			}
+		}
+#endif
+
+		m_Segments.clear();
+		m_StagingSize = 0;
+		m_Pending = 0;
+
+#ifndef _WIN32
+		SERIALIZATION_CHECK( !Failed, "Failed to write to file." );
+#endif
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		if ( a_Size >= m_Threshold )
+		{
+			m_Segments.push_back( { ( const uint8_t* )a_From, a_Size } );
+		}
+		else
+		{
+			if ( m_StagingSize + a_Size > m_StagingCapacity )
+			{
+				Flush();
+			}
+
+			uint8_t* Tail = m_Staging + m_StagingSize;
+			memcpy( Tail, a_From, a_Size );
+			m_StagingSize += a_Size;
+
+			if ( !m_Segments.empty() && m_Segments.back().Data + m_Segments.back().Size == Tail )
+			{
+				m_Segments.back().Size += a_Size;
+			}
+			else
+			{
+				m_Segments.push_back( { Tail, a_Size } );
+			}
+		}
+
+		m_Pending += a_Size;
+		m_Position += a_Size;
+
+		if ( m_Position > m_Size )
+		{
+			m_Size = m_Position;
+		}
+
+		if ( m_Segments.size() >= MaxSegments )
+		{
+			Flush();
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		Flush();
+		m_File.Seek( m_Position );
+		m_File.Read( a_To, a_Size );
+		m_Position += a_Size;
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		Flush();
+		m_Position = a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return m_Position;
+	}
+
+	inline bool End() const
+	{
+		return m_Position >= m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+private:
+
+	FileStream             m_File;
+	uint8_t*               m_Staging;
+	size_t                 m_StagingSize;
+	size_t                 m_StagingCapacity;
+	size_t                 m_Threshold;
+	size_t                 m_Position;
+	size_t                 m_Pending;
+	size_t                 m_Size;
+	std::vector< Segment > m_Segments;
+#ifndef _WIN32
+	std::vector< iovec >   m_Vectors;
+#endif
+};
+
+// Write() fills one of several blocks while the others are written in the background, through
+// io_uring where the kernel allows it and a worker thread otherwise.
+class AsyncFileStream
+{
+	struct Block
+	{
+		uint8_t* Data;
+		size_t   Offset;
+		size_t   Size;
+		bool     Busy;
+#ifdef SERIALIZATION_IO_URING
+		uint64_t Sequence;
+		iovec    Vector;
+#endif
+	};
+
+	struct Job
+	{
+		size_t               Index;
+		std::promise< void > Done;
+	};
+
+#ifdef SERIALIZATION_IO_URING
+	struct Waiter
+	{
+		uint64_t             Sequence;
+		std::promise< void > Done;
+	};
+#endif
+
+#ifdef SERIALIZATION_IO_URING
+	class Ring
+	{
+	public:
+
+		Ring()
+			: m_Handle( -1 )
+			, m_Queue( MAP_FAILED )
+			, m_Completion( MAP_FAILED )
+			, m_Entries( MAP_FAILED )
+			, m_QueueSize( 0 )
+			, m_CompletionSize( 0 )
+			, m_EntriesSize( 0 )
+		{ }
+
+		~Ring()
+		{
+			Close();
+		}
+
+		inline bool IsOpen() const
+		{
+			return m_Handle != -1;
+		}
+
+		bool Open( unsigned a_Entries )
+		{
+			io_uring_params Parameters;
+			memset( &Parameters, 0, sizeof( Parameters ) );
+			m_Handle = ( int )syscall( __NR_io_uring_setup, a_Entries, &Parameters );
+
+			if ( m_Handle < 0 )
+			{
+				m_Handle = -1;
+				return false;
+			}
+
+			m_QueueSize = Parameters.sq_off.array + Parameters.sq_entries * sizeof( unsigned );
+			m_CompletionSize = Parameters.cq_off.cqes + Parameters.cq_entries * sizeof( io_uring_cqe );
+			m_EntriesSize = Parameters.sq_entries * sizeof( io_uring_sqe );
+			bool Single = false;
+
+#ifdef IORING_FEAT_SINGLE_MMAP
+			if ( Parameters.features & IORING_FEAT_SINGLE_MMAP )
+			{
+				Single = true;
+				m_QueueSize = m_CompletionSize = m_QueueSize > m_CompletionSize ? m_QueueSize : m_CompletionSize;
+			}
+#endif
+
+			m_Queue = mmap( nullptr, m_QueueSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Handle, IORING_OFF_SQ_RING );
+			m_Completion = Single ? m_Queue : mmap( nullptr, m_CompletionSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Handle, IORING_OFF_CQ_RING );
+			m_Entries = mmap( nullptr, m_EntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Handle, IORING_OFF_SQES );
+
+			if ( m_Queue == MAP_FAILED || m_Completion == MAP_FAILED || m_Entries == MAP_FAILED )
+			{
+				Close();
+				return false;
+			}
+
+			uint8_t* Queue = ( uint8_t* )m_Queue;
+			uint8_t* Completion = ( uint8_t* )m_Completion;
+			m_QueueTail = ( unsigned* )( Queue + Parameters.sq_off.tail );
+			m_QueueMask = ( unsigned* )( Queue + Parameters.sq_off.ring_mask );
+			m_QueueArray = ( unsigned* )( Queue + Parameters.sq_off.array );
+			m_CompletionHead = ( unsigned* )( Completion + Parameters.cq_off.head );
+			m_CompletionTail = ( unsigned* )( Completion + Parameters.cq_off.tail );
+			m_CompletionMask = ( unsigned* )( Completion + Parameters.cq_off.ring_mask );
+			m_Completions = ( io_uring_cqe* )( Completion + Parameters.cq_off.cqes );
+			return true;
+		}
+
+		void Close()
+		{
+			if ( m_Entries != MAP_FAILED )
+			{
+				munmap( m_Entries, m_EntriesSize );
+			}
+
+			if ( m_Completion != MAP_FAILED && m_Completion != m_Queue )
+			{
+				munmap( m_Completion, m_CompletionSize );
+			}
+
+			if ( m_Queue != MAP_FAILED )
+			{
+				munmap( m_Queue, m_QueueSize );
+			}
+
+			if ( m_Handle != -1 )
+			{
+				close( m_Handle );
+			}
+
+			m_Handle = -1;
+			m_Queue = m_Completion = m_Entries = MAP_FAILED;
+		}
+
+		// Returns false when the kernel did not take the write, which then has to be done some other way.
+		bool Submit( int a_File, const iovec* a_Vector, size_t a_Offset, uint64_t a_Tag )
+		{
+			return Push( IORING_OP_WRITEV, a_File, a_Vector, a_Offset, a_Tag );
+		}
+
+		// Queues an entry that completes at once, to wake the thread waiting in Reap.
+		bool Wake( uint64_t a_Tag )
+		{
+			return Push( IORING_OP_NOP, -1, nullptr, 0, a_Tag );
+		}
+
+		template < typename _Callback >
+		bool Reap( _Callback&& a_Callback )
+		{
+			unsigned Head = *m_CompletionHead;
+
+			while ( Head == __atomic_load_n( m_CompletionTail, __ATOMIC_ACQUIRE ) )
+			{
+				if ( syscall( __NR_io_uring_enter, m_Handle, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0 ) < 0 && errno != EINTR )
+				{
+					return false;
+				}
+			}
+
+			while ( Head != __atomic_load_n( m_CompletionTail, __ATOMIC_ACQUIRE ) )
+			{
+				io_uring_cqe& Entry = m_Completions[ Head & *m_CompletionMask ];
+				a_Callback( Entry.user_data, Entry.res );
+				++Head;
+			}
+
+			__atomic_store_n( m_CompletionHead, Head, __ATOMIC_RELEASE );
+			return true;
+		}
+
+	private:
+
+		bool Push( uint8_t a_Opcode, int a_File, const iovec* a_Vector, size_t a_Offset, uint64_t a_Tag )
+		{
+			unsigned      Tail = *m_QueueTail;
+			unsigned      Index = Tail & *m_QueueMask;
+			io_uring_sqe* Entry = ( io_uring_sqe* )m_Entries + Index;
+
+			memset( Entry, 0, sizeof( io_uring_sqe ) );
+			Entry->opcode = a_Opcode;
+			Entry->fd = a_File;
+			Entry->addr = ( uint64_t )( uintptr_t )a_Vector;
+			Entry->len = a_Vector ? 1 : 0;
+			Entry->off = ( uint64_t )a_Offset;
+			Entry->user_data = a_Tag;
+			m_QueueArray[ Index ] = Index;
+			__atomic_store_n( m_QueueTail, Tail + 1, __ATOMIC_RELEASE );
+
+			long Submitted;
+			while ( ( Submitted = syscall( __NR_io_uring_enter, m_Handle, 1, 0, 0, nullptr, 0 ) ) < 0 && errno == EINTR );
+
+			if ( Submitted < 1 )
+			{
+				// The kernel consumed nothing, so the entry is taken back rather than left for a later submission.
+				__atomic_store_n( m_QueueTail, Tail, __ATOMIC_RELEASE );
+				return false;
+			}
+
+			return true;
+		}
+
+		int           m_Handle;
+		void*         m_Queue;
+		void*         m_Completion;
+		void*         m_Entries;
+		size_t        m_QueueSize;
+		size_t        m_CompletionSize;
+		size_t        m_EntriesSize;
+		unsigned*     m_QueueTail;
+		unsigned*     m_QueueMask;
+		unsigned*     m_QueueArray;
+		unsigned*     m_CompletionHead;
+		unsigned*     m_CompletionTail;
+		unsigned*     m_CompletionMask;
+		io_uring_cqe* m_Completions;
+	};
+#endif
+
+public:
+
+	static constexpr size_t DefaultBlockSize = 1048576;
+	static constexpr size_t DefaultBlockCount = 3;
+
+	AsyncFileStream()
+		: m_Memory( nullptr )
+		, m_BlockSize( 0 )
+		, m_Current( 0 )
+		, m_Fill( 0 )
+		, m_Position( 0 )
+		, m_Size( 0 )
+		, m_InFlight( 0 )
+#ifdef SERIALIZATION_IO_URING
+		, m_Submitted( 0 )
+#endif
+		, m_Stop( false )
+	{ }
+
+	AsyncFileStream( const char* a_Path, size_t a_BlockSize = DefaultBlockSize, size_t a_BlockCount = DefaultBlockCount )
+		: AsyncFileStream()
+	{
+		Open( a_Path, a_BlockSize, a_BlockCount );
+	}
+
+	~AsyncFileStream()
+	{
+		Close();
+	}
+
+	void Open( const char* a_Path, size_t a_BlockSize = DefaultBlockSize, size_t a_BlockCount = DefaultBlockCount )
+	{
+		if ( m_File.IsOpen() )
+		{
+			Close();
+		}
+
+		SERIALIZATION_ASSERT( a_BlockSize > 0 && a_BlockCount > 1, "AsyncFileStream needs at least two non-empty blocks." );
+
+		m_File.Open( a_Path );
+		m_BlockSize = a_BlockSize;
+		m_Memory = ( uint8_t* )malloc( a_BlockSize * a_BlockCount );
+		m_Blocks.resize( a_BlockCount );
+
+		for ( size_t i = 0; i < a_BlockCount; ++i )
+		{
+			m_Blocks[ i ].Data = m_Memory + i * a_BlockSize;
+			m_Blocks[ i ].Busy = false;
+		}
+
+		m_Current = 0;
+		m_Fill = 0;
+		m_Position = 0;
+		m_Size = m_File.Size();
+		m_InFlight = 0;
+		m_Stop = false;
+
+#ifdef SERIALIZATION_IO_URING
+		m_Submitted = 0;
+
+		if ( m_Ring.Open( ( unsigned )a_BlockCount + 1 ) )
+		{
+			m_Worker = std::thread( &AsyncFileStream::Complete, this );
+			return;
+		}
+#endif
+
+		m_Worker = std::thread( &AsyncFileStream::Work, this );
+	}
+
+	void Close()
+	{
+		if ( !m_File.IsOpen() )
+		{
+			return;
+		}
+
+		Wait();
+
+		if ( m_Worker.joinable() )
+		{
+			{
+				std::lock_guard< std::mutex > Lock( m_Mutex );
+				m_Stop = true;
+			}
+
+#ifdef SERIALIZATION_IO_URING
+			if ( m_Ring.IsOpen() )
+			{
+				bool Woken = m_Ring.Wake( WakeTag );
+				SERIALIZATION_ASSERT( Woken, "Failed to stop the io_uring completion thread." );
+				( void )Woken;
+			}
+#endif
+
+			m_Signal.notify_all();
+			m_Worker.join();
+		}
+
+#ifdef SERIALIZATION_IO_URING
+		m_Ring.Close();
+#endif
+
+		m_File.Close();
+		free( m_Memory );
+		m_Memory = nullptr;
+		m_Blocks.clear();
+		m_Size = 0;
+	}
+
+	// Starts writing whatever is buffered. The returned future is ready once every write issued so far has reached the file.
+	std::future< void > Flush()
+	{
+		Submit();
+
+		std::promise< void > Done;
+		std::future< void > Result = Done.get_future();
+
+		{
+			std::lock_guard< std::mutex > Lock( m_Mutex );
+
+#ifdef SERIALIZATION_IO_URING
+			if ( m_Ring.IsOpen() )
+			{
+				m_Waiters.push_back( { m_Submitted, std::move( Done ) } );
+				Settle();
+				return Result;
+			}
+#endif
+
+			m_Jobs.push_back( { m_Blocks.size(), std::move( Done ) } );
+		}
+
+		m_Signal.notify_all();
+		return Result;
+	}
+
+	void Wait()
+	{
+		Submit();
+		Drain();
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		const uint8_t* From = ( const uint8_t* )a_From;
+
+		while ( a_Size )
+		{
+			size_t Count = m_BlockSize - m_Fill < a_Size ? m_BlockSize - m_Fill : a_Size;
+			memcpy( m_Blocks[ m_Current ].Data + m_Fill, From, Count );
+			m_Fill += Count;
+			m_Position += Count;
+			From += Count;
+			a_Size -= Count;
+
+			if ( m_Fill == m_BlockSize )
+			{
+				Submit();
+			}
+		}
+
+		if ( m_Position > m_Size )
+		{
+			m_Size = m_Position;
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		Wait();
+		m_File.Seek( m_Position );
+		m_File.Read( a_To, a_Size );
+		m_Position += a_Size;
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		Wait();
+		m_Position = a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return m_Position;
+	}
+
+	inline bool End() const
+	{
+		return m_Position >= m_Size;
+	}
+
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
+
+	inline size_t BlockSize() const
+	{
+		return m_BlockSize;
+	}
+
+	inline bool IsOpen() const
+	{
+		return m_File.IsOpen();
+	}
+
+private:
+
+	void Submit()
+	{
+		if ( !m_Fill )
+		{
+			return;
+		}
+
+		Block& Current = m_Blocks[ m_Current ];
+		Current.Offset = m_Position - m_Fill;
+		Current.Size = m_Fill;
+
+#ifdef SERIALIZATION_IO_URING
+		if ( m_Ring.IsOpen() )
+		{
+			{
+				std::lock_guard< std::mutex > Lock( m_Mutex );
+				Current.Busy = true;
+				Current.Sequence = ++m_Submitted;
+				++m_InFlight;
+			}
+
+			Current.Vector.iov_base = Current.Data;
+			Current.Vector.iov_len = Current.Size;
+
+			if ( !m_Ring.Submit( m_File.NativeHandle(), &Current.Vector, Current.Offset, m_Current ) )
+			{
+				WriteAt( Current.Data, Current.Size, Current.Offset );
+
+				std::lock_guard< std::mutex > Lock( m_Mutex );
+				Current.Busy = false;
+				--m_InFlight;
+				Settle();
+			}
+		}
+		else
+#endif
+		{
+			std::lock_guard< std::mutex > Lock( m_Mutex );
+			Current.Busy = true;
+			m_Jobs.push_back( { m_Current, std::promise< void >() } );
+			++m_InFlight;
+		}
+
+		m_Signal.notify_all();
+		m_Fill = 0;
+		m_Current = ( m_Current + 1 ) % m_Blocks.size();
+		Acquire( m_Current );
+	}
+
+	void Acquire( size_t a_Index )
+	{
+		std::unique_lock< std::mutex > Lock( m_Mutex );
+		m_Signal.wait( Lock, [ & ]() { return !m_Blocks[ a_Index ].Busy; } );
+	}
+
+	void Drain()
+	{
+		std::unique_lock< std::mutex > Lock( m_Mutex );
+		m_Signal.wait( Lock, [ this ]() { return m_InFlight == 0; } );
+	}
+
+#ifdef SERIALIZATION_IO_URING
+	static constexpr uint64_t WakeTag = ~uint64_t( 0 );
+
+	// Reaps completions on the worker thread, so that blocks and flushes are released without the writer's help.
+	void Complete()
+	{
+		bool Stop = false;
+
+		while ( !Stop )
+		{
+			bool Reaped = m_Ring.Reap( [ & ]( uint64_t a_Tag, int32_t a_Result )
+			{
+				if ( a_Tag == WakeTag )
+				{
+					Stop = true;
+					return;
+				}
+
+				std::lock_guard< std::mutex > Lock( m_Mutex );
+				Block& Completed = m_Blocks[ ( size_t )a_Tag ];
+				size_t Written = a_Result > 0 ? ( size_t )a_Result : 0;
+
+				if ( Written < Completed.Size )
+				{
+					WriteAt( Completed.Data + Written, Completed.Size - Written, Completed.Offset + Written );
+				}
+
+				Completed.Busy = false;
+				--m_InFlight;
+				Settle();
+			} );
+
+			SERIALIZATION_ASSERT( Reaped, "Failed to wait for io_uring completions." );
+			( void )Reaped;
+			m_Signal.notify_all();
+		}
+	}
+
+	// Fulfils the flushes whose blocks have all been written. Called with m_Mutex held.
+	void Settle()
+	{
+		for ( auto Pending = m_Waiters.begin(); Pending != m_Waiters.end(); )
+		{
+			bool Busy = false;
+
+			for ( const Block& Block : m_Blocks )
+			{
+				Busy = Busy || ( Block.Busy && Block.Sequence <= Pending->Sequence );
+			}
+
+			if ( Busy )
+			{
+				++Pending;
+			}
+			else
+			{
+				Pending->Done.set_value();
+				Pending = m_Waiters.erase( Pending );
+			}
+		}
+	}
+
+	// Writes synchronously at a_Offset without moving the position of m_File, which another thread may be using.
+	void WriteAt( const uint8_t* a_From, size_t a_Size, size_t a_Offset )
+	{
+		while ( a_Size )
+		{
+			ssize_t Written = pwrite( m_File.NativeHandle(), a_From, a_Size, ( off_t )a_Offset );
+
+			if ( Written <= 0 )
+			{
+				if ( Written < 0 && errno == EINTR )
+				{
+					continue;
+				}
+
+				SERIALIZATION_ASSERT( false, "Failed to write to file." );
+				return;
+			}
+
+			a_From += Written;
+			a_Size -= ( size_t )Written;
+			a_Offset += ( size_t )Written;
+		}
+	}
+#endif
+
+	void Work()
+	{
+		std::unique_lock< std::mutex > Lock( m_Mutex );
+
+		while ( true )
+		{
+			m_Signal.wait( Lock, [ this ]() { return m_Stop || !m_Jobs.empty(); } );
+
+			if ( m_Jobs.empty() )
+			{
+				return;
+			}
+
+			Job Current = std::move( m_Jobs.front() );
+			m_Jobs.pop_front();
+
+			if ( Current.Index < m_Blocks.size() )
+			{
+				Block& Pending = m_Blocks[ Current.Index ];
+				Lock.unlock();
+				m_File.Seek( Pending.Offset );
+				m_File.Write( Pending.Data, Pending.Size );
+				Lock.lock();
+				Pending.Busy = false;
+				--m_InFlight;
+			}
+			else
+			{
+				Current.Done.set_value();
+			}
+
+			m_Signal.notify_all();
+		}
+	}
+
+	FileStream              m_File;
+	uint8_t*                m_Memory;
+	std::vector< Block >    m_Blocks;
+	size_t                  m_BlockSize;
+	size_t                  m_Current;
+	size_t                  m_Fill;
+	size_t                  m_Position;
+	size_t                  m_Size;
+	size_t                  m_InFlight;
+#ifdef SERIALIZATION_IO_URING
+	uint64_t                m_Submitted;
+	std::vector< Waiter >   m_Waiters;
+#endif
+	bool                    m_Stop;
+	std::deque< Job >       m_Jobs;
+	std::mutex              m_Mutex;
+	std::condition_variable m_Signal;
+	std::thread             m_Worker;
+#ifdef SERIALIZATION_IO_URING
+	Ring                    m_Ring;
+#endif
+};
+
+// Produces and reads the LZ4 block format without depending on liblz4.
+class LzCodec
+{
+	static constexpr size_t HashBits = 12;
+	static constexpr size_t MinMatch = 4;
+	static constexpr size_t LastLiterals = 5;
+	static constexpr size_t MatchLimit = 12;
+	static constexpr size_t MaxDistance = 65535;
+
+	static inline uint32_t Load32( const uint8_t* a_From )
+	{
+		uint32_t Value;
+		memcpy( &Value, a_From, sizeof( uint32_t ) );
+		return Value;
+	}
+
+	static inline uint32_t Hash( uint32_t a_Value )
+	{
+		return ( a_Value * 2654435761u ) >> ( 32 - HashBits );
+	}
+
+	static inline uint8_t* WriteLength( uint8_t* a_To, size_t a_Length )
+	{
+		while ( a_Length >= 255 )
+		{
+			*a_To++ = 255;
+			a_Length -= 255;
+		}
+
+		*a_To++ = ( uint8_t )a_Length;
+		return a_To;
+	}
+
+	static inline bool ReadLength( const uint8_t*& a_From, const uint8_t* a_End, size_t& a_Length )
+	{
+		uint8_t Byte;
+
+		do
+		{
+			if ( a_From >= a_End )
+			{
+				return false;
+			}
+
+			Byte = *a_From++;
+			a_Length += Byte;
+		}
+		while ( Byte == 255 );
+
+		return true;
+	}
+
+public:
+
+	static constexpr size_t Bound( size_t a_Size )
+	{
+		return a_Size + a_Size / 255 + 16;
+	}
+
+	static size_t Compress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_Capacity )
+	{
+		if ( a_Capacity < Bound( a_Size ) )
+		{
+			return 0;
+		}
+
+		const uint8_t* End = a_From + a_Size;
+		const uint8_t* Anchor = a_From;
+		uint8_t*       Output = a_To;
+
+		if ( a_Size > MatchLimit )
+		{
+			uint32_t       Table[ 1 << HashBits ] = {};
+			const uint8_t* Input = a_From;
+			const uint8_t* Limit = End - MatchLimit;
+
+			while ( Input < Limit )
+			{
+				uint32_t       Sequence = Load32( Input );
+				uint32_t&      Slot = Table[ Hash( Sequence ) ];
+				const uint8_t* Candidate = a_From + Slot;
+				Slot = ( uint32_t )( Input - a_From );
+
+				if ( Candidate >= Input || ( size_t )( Input - Candidate ) > MaxDistance || Load32( Candidate ) != Sequence )
+				{
+					++Input;
+					continue;
+				}
+
+				const uint8_t* MatchEnd = Input + MinMatch;
+				const uint8_t* Reference = Candidate + MinMatch;
+
+				while ( MatchEnd < End - LastLiterals && *MatchEnd == *Reference )
+				{
+					++MatchEnd;
+					++Reference;
+				}
+
+				size_t   Literals = Input - Anchor;
+				size_t   Length = MatchEnd - Input - MinMatch;
+				size_t   Distance = Input - Candidate;
+				uint8_t* Token = Output++;
+
+				*Token = ( uint8_t )( ( Literals < 15 ? Literals : 15 ) << 4 );
+
+				if ( Literals >= 15 )
+				{
+					Output = WriteLength( Output, Literals - 15 );
+				}
+
+				memcpy( Output, Anchor, Literals );
+				Output += Literals;
+				*Output++ = ( uint8_t )( Distance & 0xFF );
+				*Output++ = ( uint8_t )( Distance >> 8 );
+				*Token |= ( uint8_t )( Length < 15 ? Length : 15 );
+
+				if ( Length >= 15 )
+				{
+					Output = WriteLength( Output, Length - 15 );
+				}
+
+				Input = Anchor = MatchEnd;
+			}
+		}
+
+		size_t Literals = End - Anchor;
+		*Output++ = ( uint8_t )( ( Literals < 15 ? Literals : 15 ) << 4 );
+
+		if ( Literals >= 15 )
+		{
+			Output = WriteLength( Output, Literals - 15 );
+		}
+
+		memcpy( Output, Anchor, Literals );
+		Output += Literals;
+		return Output - a_To;
+	}
+
+	static bool Decompress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_RawSize )
+	{
+		const uint8_t* Input = a_From;
+		const uint8_t* InputEnd = a_From + a_Size;
+		uint8_t*       Output = a_To;
+		uint8_t*       OutputEnd = a_To + a_RawSize;
+
+		while ( Input < InputEnd )
+		{
+			uint8_t Token = *Input++;
+			size_t  Literals = Token >> 4;
+
+			if ( Literals == 15 && !ReadLength( Input, InputEnd, Literals ) )
+			{
+				return false;
+			}
+
+			if ( Literals > ( size_t )( InputEnd - Input ) || Literals > ( size_t )( OutputEnd - Output ) )
+			{
+				return false;
+			}
+
+			memcpy( Output, Input, Literals );
+			Input += Literals;
+			Output += Literals;
+
+			if ( Input == InputEnd )
+			{
+				break;
+			}
+
+			if ( InputEnd - Input < 2 )
+			{
+				return false;
+			}
+
+			size_t Distance = Input[ 0 ] | ( size_t )Input[ 1 ] << 8;
+			size_t Length = Token & 15;
+			Input += 2;
+
+			if ( Length == 15 && !ReadLength( Input, InputEnd, Length ) )
+			{
+				return false;
+			}
+
+			Length += MinMatch;
+
+			if ( !Distance || Distance > ( size_t )( Output - a_To ) || Length > ( size_t )( OutputEnd - Output ) )
+			{
+				return false;
+			}
+
+			const uint8_t* Reference = Output - Distance;
+
+			if ( Distance >= Length )
+			{
+				memcpy( Output, Reference, Length );
+				Output += Length;
+			}
+			else
+			{
+				while ( Length-- )
+				{
+					*Output++ = *Reference++;
+				}
+			}
+		}
+
+		return Output == OutputEnd;
+	}
+};
+
+#ifdef SERIALIZATION_LZ4
+class Lz4Codec
+{
+public:
+
+	static constexpr size_t Bound( size_t a_Size )
+	{
+		return a_Size + a_Size / 255 + 16;
+	}
+
+	static size_t Compress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_Capacity )
+	{
+		int Result = LZ4_compress_default( ( const char* )a_From, ( char* )a_To, ( int )a_Size, ( int )a_Capacity );
+		return Result > 0 ? ( size_t )Result : 0;
+	}
+
+	static bool Decompress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_RawSize )
+	{
+		return LZ4_decompress_safe( ( const char* )a_From, ( char* )a_To, ( int )a_Size, ( int )a_RawSize ) == ( int )a_RawSize;
+	}
+};
+#endif
+
+#ifdef SERIALIZATION_ZSTD
+class ZstdCodec
+{
+public:
+
+	static size_t Bound( size_t a_Size )
+	{
+		return ZSTD_compressBound( a_Size );
+	}
+
+	static size_t Compress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_Capacity )
+	{
+		size_t Result = ZSTD_compress( a_To, a_Capacity, a_From, a_Size, 1 );
+		return ZSTD_isError( Result ) ? 0 : Result;
+	}
+
+	static bool Decompress( const uint8_t* a_From, size_t a_Size, uint8_t* a_To, size_t a_RawSize )
+	{
+		return ZSTD_decompress( a_To, a_RawSize, a_From, a_Size ) == a_RawSize;
+	}
+};
+#endif
+
+// Compresses the bytes written to the wrapped stream in independently decodable blocks. A stream is either written from
+// the start or read; reads seek by block, and SetParallelism compresses that many blocks at a time on threads that
+// live as long as the stream.
+template < typename _Stream, typename _Codec = LzCodec >
+class CompressedStream
+{
+	struct Block
+	{
+		std::vector< uint8_t > Raw;
+		std::vector< uint8_t > Packed;
+		size_t                 Size;
+		uint32_t               Header[ 2 ];
+	};
+
+	enum class Mode
+	{
+		None,
+		Writing,
+		Reading
+	};
+
+	static constexpr uint32_t Stored = 0x80000000u;
+	static constexpr size_t   NoBlock = ~( size_t )0;
+
+public:
+
+	static constexpr size_t DefaultBlockSize = 65536;
+
+	template < typename... Args >
+	CompressedStream( Args&&... a_Args )
+		: m_Stream( std::forward< Args >( a_Args )... )
+		, m_WriteBlockSize( DefaultBlockSize )
+		, m_BlockSize( DefaultBlockSize )
+		, m_Parallelism( 1 )
+	{
+		Reset();
+	}
+
+	~CompressedStream()
+	{
+		Flush();
+	}
+
+	template < typename... Args >
+	void Open( Args&&... a_Args )
+	{
+		Close();
+		m_Stream.Open( std::forward< Args >( a_Args )... );
+	}
+
+	void Close()
+	{
+		Flush();
+		m_Stream.Close();
+		Reset();
+	}
+
+	inline _Stream& GetStream()
+	{
+		return m_Stream;
+	}
+
+	void SetBlockSize( size_t a_BlockSize )
+	{
+		SERIALIZATION_ASSERT( m_Mode == Mode::None, "The block size must be set before the stream is used." );
+		SERIALIZATION_ASSERT( a_BlockSize > 0 && a_BlockSize < Stored, "Invalid compressed block size." );
+		m_WriteBlockSize = a_BlockSize;
+		m_BlockSize = a_BlockSize;
+	}
+
+	// The block size of the stream being read, or the one new blocks are written with.
+	inline size_t BlockSize() const
+	{
+		return m_BlockSize;
+	}
+
+	void SetParallelism( size_t a_Threads )
+	{
+		SERIALIZATION_ASSERT( m_Mode == Mode::None, "Parallelism must be set before the stream is used." );
+		m_Parallelism = a_Threads ? a_Threads : std::thread::hardware_concurrency();
+		m_Parallelism = m_Parallelism ? m_Parallelism : 1;
+	}
+
+	// Compresses and writes the buffered blocks. Later writes start a new block.
+	void Flush()
+	{
+		if constexpr ( Serialization::HasWrite< _Stream > )
+		{
+			if ( m_Mode == Mode::Writing )
+			{
+				Emit( m_Blocks[ m_Current ].Size ? m_Current + 1 : m_Current );
+			}
+		}
+	}
+
+	inline void Write( const void* a_From, size_t a_Size )
+	{
+		if ( m_Mode != Mode::Writing )
+		{
+			BeginWrite();
+		}
+
+		const uint8_t* From = ( const uint8_t* )a_From;
+		m_Position += a_Size;
+		m_Size = m_Position;
+
+		while ( a_Size )
+		{
+			Block& Current = m_Blocks[ m_Current ];
+			size_t Count = m_BlockSize - Current.Size < a_Size ? m_BlockSize - Current.Size : a_Size;
+			memcpy( Current.Raw.data() + Current.Size, From, Count );
+			Current.Size += Count;
+			From += Count;
+			a_Size -= Count;
+
+			if ( Current.Size == m_BlockSize && ++m_Current == m_Blocks.size() )
+			{
+				Emit( m_Current );
+			}
+		}
+	}
+
+	inline void Read( void* a_To, size_t a_Size )
+	{
+		if ( m_Mode != Mode::Reading )
+		{
+			BeginRead();
+		}
+
+		uint8_t* To = ( uint8_t* )a_To;
+
+		while ( a_Size )
+		{
+			if ( m_Loaded == NoBlock || m_Position < m_Starts[ m_Loaded ] || m_Position >= m_Starts[ m_Loaded ] + m_Decoded.Size )
+			{
+				bool Loaded = Load( Locate( m_Position ) );
+				SERIALIZATION_CHECK( Loaded, "Read exceeds the end of the compressed stream." );
+			}
+
+			size_t Offset = m_Position - m_Starts[ m_Loaded ];
+			size_t Count = m_Decoded.Size - Offset < a_Size ? m_Decoded.Size - Offset : a_Size;
+			memcpy( To, m_Decoded.Raw.data() + Offset, Count );
+			m_Position += Count;
+			To += Count;
+			a_Size -= Count;
+		}
+	}
+
+	inline void Seek( size_t a_Position )
+	{
+		if ( m_Mode == Mode::Writing )
+		{
+			SERIALIZATION_ASSERT( a_Position == m_Position, "A compressed stream can only be written sequentially." );
+			return;
+		}
+
+		if ( m_Mode != Mode::Reading )
+		{
+			BeginRead();
+		}
+
+		m_Position = a_Position;
+	}
+
+	inline size_t Position() const
+	{
+		return m_Position;
+	}
+
+	inline bool End()
+	{
+		return m_Position >= Size();
+	}
+
+	inline size_t Size()
+	{
+		if ( m_Mode == Mode::None )
+		{
+			BeginRead();
+		}
+
+		if ( m_Mode == Mode::Reading )
+		{
+			while ( Index() );
+		}
+
+		return m_Size;
+	}
+
+private:
+
+	void Reset()
+	{
+		m_Mode = Mode::None;
+		m_BlockSize = m_WriteBlockSize;
+		m_Position = 0;
+		m_Size = 0;
+		m_Offset = 0;
+		m_Current = 0;
+		m_Loaded = NoBlock;
+		m_Blocks.clear();
+		m_Offsets.clear();
+		m_Starts.clear();
+	}
+
+	void BeginWrite()
+	{
+		SERIALIZATION_ASSERT( m_Mode == Mode::None || !m_Size, "A compressed stream cannot be written after it has been read." );
+
+		// Reading an empty stream leaves nothing to keep, but it did replace the block size with the stored one.
+		Reset();
+		m_Mode = Mode::Writing;
+		m_Blocks.resize( m_Parallelism );
+
+		for ( auto& Current : m_Blocks )
+		{
+			Current.Raw.resize( m_BlockSize );
+			Current.Packed.resize( _Codec::Bound( m_BlockSize ) );
+			Current.Size = 0;
+		}
+
+		if ( m_Parallelism > 1 && ( !m_Pool || m_Pool->Size() != m_Parallelism - 1 ) )
+		{
+			m_Pool.reset( new ThreadPool( m_Parallelism - 1 ) );
+		}
+
+		uint32_t BlockSize = ( uint32_t )m_BlockSize;
+		m_Stream.Seek( 0 );
+		WriteWords( &BlockSize, 1 );
+		m_Offset = sizeof( uint32_t );
+	}
+
+	void BeginRead()
+	{
+		SERIALIZATION_ASSERT( m_Mode == Mode::None, "A compressed stream cannot be read after it has been written." );
+
+		m_Mode = Mode::Reading;
+		uint32_t BlockSize = 0;
+
+		// An empty stream has no blocks, anything else must start with a valid block size.
+		if ( m_Stream.Size() )
+		{
+			SERIALIZATION_CHECK( m_Stream.Size() >= sizeof( uint32_t ), "Truncated compressed stream." );
+			m_Stream.Seek( 0 );
+			ReadWords( &BlockSize, 1 );
+			SERIALIZATION_CHECK( BlockSize && BlockSize < Stored, "Invalid compressed block size." );
+		}
+
+		m_BlockSize = BlockSize;
+		m_Offset = sizeof( uint32_t );
+		m_Decoded.Raw.resize( m_BlockSize );
+		m_Decoded.Packed.resize( _Codec::Bound( m_BlockSize ) );
+		m_Decoded.Size = 0;
+	}
+
+	// The block size and block headers are little-endian on every host.
+	void WriteWords( const uint32_t* a_Words, size_t a_Count )
+	{
+		uint32_t Words[ 2 ];
+
+		for ( size_t i = 0; i < a_Count; ++i )
+		{
+			Words[ i ] = Serialization::ToByteOrder( a_Words[ i ], ByteOrder::Little );
+		}
+
+		m_Stream.Write( Words, sizeof( uint32_t ) * a_Count );
+	}
+
+	void ReadWords( uint32_t* a_Words, size_t a_Count )
+	{
+		m_Stream.Read( a_Words, sizeof( uint32_t ) * a_Count );
+
+		for ( size_t i = 0; i < a_Count; ++i )
+		{
+			a_Words[ i ] = Serialization::ToByteOrder( a_Words[ i ], ByteOrder::Little );
+		}
+	}
+
+	void Emit( size_t a_Count )
+	{
+		auto Work = [ this ]( size_t a_Index )
+		{
+			Block& Current = m_Blocks[ a_Index ];
+			size_t Packed = _Codec::Compress( Current.Raw.data(), Current.Size, Current.Packed.data(), Current.Packed.size() );
+			Current.Header[ 0 ] = Packed && Packed < Current.Size ? ( uint32_t )Packed : Stored | ( uint32_t )Current.Size;
+			Current.Header[ 1 ] = ( uint32_t )Current.Size;
+		};
+
+		if ( m_Pool )
+		{
+			m_Pool->Run( a_Count, Work );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_Count; ++i )
+			{
+				Work( i );
+			}
+		}
+
+		for ( size_t i = 0; i < a_Count; ++i )
+		{
+			Block& Current = m_Blocks[ i ];
+			size_t Packed = Current.Header[ 0 ] & ~Stored;
+			WriteWords( Current.Header, 2 );
+			m_Stream.Write( Current.Header[ 0 ] & Stored ? Current.Raw.data() : Current.Packed.data(), Packed );
+			m_Offset += sizeof( Current.Header ) + Packed;
+			Current.Size = 0;
+		}
+
+		if constexpr ( Serialization::RetainsWrites< _Stream > )
+		{
+			m_Stream.Flush();
+		}
+
+		m_Current = 0;
+	}
+
+	// Whether a block header read from the stream describes a block this stream can decode into its buffers.
+	bool IsValid( const uint32_t* a_Header ) const
+	{
+		size_t Packed = a_Header[ 0 ] & ~Stored;
+		size_t Raw = a_Header[ 1 ];
+
+		if ( !Raw || Raw > m_BlockSize )
+		{
+			return false;
+		}
+
+		return a_Header[ 0 ] & Stored ? Packed == Raw : Packed && Packed <= _Codec::Bound( m_BlockSize );
+	}
+
+	bool Index()
+	{
+		uint32_t Header[ 2 ];
+
+		if ( !m_BlockSize || m_Offset + sizeof( Header ) > m_Stream.Size() )
+		{
+			return false;
+		}
+
+		m_Stream.Seek( m_Offset );
+		ReadWords( Header, 2 );
+
+		if ( !IsValid( Header ) || m_Offset + sizeof( Header ) + ( Header[ 0 ] & ~Stored ) > m_Stream.Size() )
+		{
+			return false;
+		}
+
+		m_Offsets.push_back( m_Offset );
+		m_Starts.push_back( m_Size );
+		m_Offset += sizeof( Header ) + ( Header[ 0 ] & ~Stored );
+		m_Size += Header[ 1 ];
+		return true;
+	}
+
+	size_t Locate( size_t a_Position )
+	{
+		while ( m_Size <= a_Position && Index() );
+
+		if ( a_Position >= m_Size )
+		{
+			return NoBlock;
+		}
+
+		return ( size_t )( std::upper_bound( m_Starts.begin(), m_Starts.end(), a_Position ) - m_Starts.begin() ) - 1;
+	}
+
+	bool Load( size_t a_Block )
+	{
+		if ( a_Block == NoBlock )
+		{
+			return false;
+		}
+
+		m_Stream.Seek( m_Offsets[ a_Block ] );
+		ReadWords( m_Decoded.Header, 2 );
+
+		if ( !IsValid( m_Decoded.Header ) )
+		{
+			m_Loaded = NoBlock;
+			return false;
+		}
+
+		m_Decoded.Size = m_Decoded.Header[ 1 ];
+		m_Loaded = a_Block;
+
+		if ( m_Decoded.Header[ 0 ] & Stored )
+		{
+			m_Stream.Read( m_Decoded.Raw.data(), m_Decoded.Size );
+			return true;
+		}
+
+		m_Stream.Read( m_Decoded.Packed.data(), m_Decoded.Header[ 0 ] );
+		bool Decoded = _Codec::Decompress( m_Decoded.Packed.data(), m_Decoded.Header[ 0 ], m_Decoded.Raw.data(), m_Decoded.Size );
+		SERIALIZATION_ASSERT( Decoded, "Corrupt compressed block." );
+		return Decoded;
+	}
+
+	_Stream                       m_Stream;
+	Mode                          m_Mode;
+	size_t                        m_WriteBlockSize;
+	size_t                        m_BlockSize;
+	size_t                        m_Parallelism;
+	size_t                        m_Position;
+	size_t                        m_Size;
+	size_t                        m_Offset;
+	size_t                        m_Current;
+	size_t                        m_Loaded;
+	std::vector< Block >          m_Blocks;
+	Block                         m_Decoded;
+	std::vector< size_t >         m_Offsets;
+	std::vector< size_t >         m_Starts;
+	std::unique_ptr< ThreadPool > m_Pool;
+};
+
+struct SectionHeader
+{
+	static constexpr uint32_t Signature = 0x434F5453;
+	static constexpr uint16_t CurrentVersion = 1;
+
+	uint32_t Tag;
+	uint16_t Version;
+	uint16_t Flags;
+	uint64_t Table;
+
+	inline bool IsValid() const
+	{
+		return Tag == Signature && Version == CurrentVersion;
+	}
+};
+
+struct SectionEntry
+{
+	std::string Name;
+	uint64_t    Number;
+	uint64_t    Offset;
+	uint64_t    Size;
+	uint64_t    Schema;
+
+	template < typename _Serializer >
+	void Serialize( _Serializer& a_Serializer ) const
+	{
+		a_Serializer << Name << Number << Offset << Size << Schema;
+	}
+
+	template < typename _Deserializer >
+	void Deserialize( _Deserializer& a_Deserializer )
+	{
+		a_Deserializer >> Name >> Number >> Offset >> Size >> Schema;
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer& Name& Number& Offset& Size& Schema;
+	}
+};
+
+// Writes values as named or numbered sections followed by a table of their offsets, so that a SectionDeserializer can load
+// any of them without reading the others. The SectionHeader at the start is rewritten by Finish, which needs a seekable stream.
+template < typename _Stream >
+class SectionSerializer
+{
+public:
 
 	template < typename... Args >
-	StreamSerializer( Args&&... a_Args )
-		: m_Stream( std::forward< Args >( a_Args )... )
+	SectionSerializer( Args&&... a_Args )
+		: m_Serializer( std::forward< Args >( a_Args )... )
+		, m_Start( 0 )
+		, m_Active( false )
+	{
+		if constexpr ( sizeof...( Args ) > 0 )
+		{
+			Begin();
+		}
+	}
+
+	~SectionSerializer()
+	{
+		Finish();
+	}
+
+	template < typename... Args >
+	inline void Open( Args&&... a_Args )
+	{
+		Finish();
+		m_Serializer.Open( std::forward< Args >( a_Args )... );
+		Begin();
+	}
+
+	inline void Close()
+	{
+		Finish();
+		m_Serializer.Close();
+	}
+
+	inline StreamSerializer< _Stream >& GetSerializer()
+	{
+		return m_Serializer;
+	}
+
+	inline _Stream& GetStream()
+	{
+		return m_Serializer.GetStream();
+	}
+
+	inline const std::vector< SectionEntry >& GetSections() const
+	{
+		return m_Sections;
+	}
+
+	template < typename T >
+	inline void Write( std::string_view a_Name, const T& a_Value )
+	{
+		Append( a_Name, 0, a_Value );
+	}
+
+	template < typename T >
+	inline void Write( uint64_t a_Number, const T& a_Value )
+	{
+		Append( std::string_view(), a_Number, a_Value );
+	}
+
+	// Writes the table and completes the header. The size encoding and chunk index must not change between sections.
+	void Finish()
+	{
+		if ( !m_Active )
+		{
+			return;
+		}
+
+		_Stream& Stream = GetStream();
+
+		SectionHeader Header;
+		Header.Tag = SectionHeader::Signature;
+		Header.Version = SectionHeader::CurrentVersion;
+		Header.Flags = ( m_Serializer.GetSizeEncoding() == SizeEncoding::Varint ? SchemaHeader::VarintFlag : 0 ) | ( m_Serializer.HasChunkIndex() ? SchemaHeader::ChunkIndexFlag : 0 );
+		Header.Table = Stream.Position() - m_Start;
+
+		m_Serializer << m_Sections;
+		size_t End = Stream.Position();
+
+		Stream.Seek( m_Start );
+		m_Serializer << Header.Tag << Header.Version << Header.Flags << Header.Table;
+		Stream.Seek( End );
+
+		m_Active = false;
+	}
+
+private:
+
+	SectionSerializer( SectionSerializer&& ) = delete;
+
+	void Begin()
+	{
+		SectionHeader Header = {};
+		m_Start = GetStream().Position();
+		GetStream().Write( &Header, sizeof( SectionHeader ) );
+		m_Sections.clear();
+		m_Active = true;
+	}
+
+	template < typename T >
+	void Append( std::string_view a_Name, uint64_t a_Number, const T& a_Value )
+	{
+		if ( !m_Active )
+		{
+			Begin();
+		}
+
+		SectionEntry Entry;
+		Entry.Name = a_Name;
+		Entry.Number = a_Number;
+		Entry.Offset = GetStream().Position() - m_Start;
+		Entry.Schema = Serialization::SchemaHash< T >;
+
+		m_Serializer << a_Value;
+
+		Entry.Size = GetStream().Position() - m_Start - Entry.Offset;
+		m_Sections.push_back( std::move( Entry ) );
+	}
+
+	StreamSerializer< _Stream > m_Serializer;
+	size_t                      m_Start;
+	bool                        m_Active;
+	std::vector< SectionEntry > m_Sections;
+};
+
+// Reads the table written by a SectionSerializer and loads sections on request by seeking to them.
+template < typename _Stream >
+class SectionDeserializer
+{
+public:
+
+	template < typename... Args >
+	SectionDeserializer( Args&&... a_Args )
+		: m_Deserializer( std::forward< Args >( a_Args )... )
+		, m_Start( 0 )
+		, m_Header()
+	{
+		if constexpr ( sizeof...( Args ) > 0 )
+		{
+			ReadTable();
+		}
+	}
+
+	template < typename... Args >
+	inline void Open( Args&&... a_Args )
+	{
+		m_Deserializer.Open( std::forward< Args >( a_Args )... );
+		ReadTable();
+	}
+
+	inline void Close()
+	{
+		m_Deserializer.Close();
+		m_Sections.clear();
+		m_Header = SectionHeader();
+	}
+
+	inline StreamDeserializer< _Stream >& GetDeserializer()
+	{
+		return m_Deserializer;
+	}
+
+	inline _Stream& GetStream()
+	{
+		return m_Deserializer.GetStream();
+	}
+
+	inline bool IsValid() const
+	{
+		return m_Header.IsValid();
+	}
+
+	inline const std::vector< SectionEntry >& GetSections() const
+	{
+		return m_Sections;
+	}
+
+	const SectionEntry* Find( std::string_view a_Name ) const
+	{
+		for ( const SectionEntry& Entry : m_Sections )
+		{
+			if ( !Entry.Name.empty() && Entry.Name == a_Name )
+			{
+				return &Entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const SectionEntry* Find( uint64_t a_Number ) const
+	{
+		for ( const SectionEntry& Entry : m_Sections )
+		{
+			if ( Entry.Name.empty() && Entry.Number == a_Number )
+			{
+				return &Entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template < typename _Key >
+	inline bool Has( const _Key& a_Key ) const
+	{
+		return Find( a_Key ) != nullptr;
+	}
+
+	// Returns false, leaving a_Value untouched, when the section is missing or was written from a different type.
+	template < typename T >
+	bool Read( const SectionEntry* a_Entry, T& a_Value )
+	{
+		if ( !a_Entry || a_Entry->Schema != Serialization::SchemaHash< T > )
+		{
+			return false;
+		}
+
+		GetStream().Seek( m_Start + ( size_t )a_Entry->Offset );
+		m_Deserializer >> a_Value;
+		return true;
+	}
+
+	template < typename T >
+	inline bool Read( std::string_view a_Name, T& a_Value )
+	{
+		return Read( Find( a_Name ), a_Value );
+	}
+
+	template < typename T >
+	inline bool Read( uint64_t a_Number, T& a_Value )
+	{
+		return Read( Find( a_Number ), a_Value );
+	}
+
+private:
+
+	SectionDeserializer( SectionDeserializer&& ) = delete;
+
+	void ReadTable()
+	{
+		_Stream& Stream = GetStream();
+
+		m_Sections.clear();
+		m_Start = Stream.Position();
+		m_Header = SectionHeader();
+		Stream.Read( &m_Header, sizeof( SectionHeader ) );
+		m_Deserializer.AdoptByteOrder( m_Header.Tag, SectionHeader::Signature );
+
+		if ( m_Deserializer.IsSwapping() )
+		{
+			m_Header.Tag = Serialization::SwapValue( m_Header.Tag );
+			m_Header.Version = Serialization::SwapValue( m_Header.Version );
+			m_Header.Flags = Serialization::SwapValue( m_Header.Flags );
+			m_Header.Table = Serialization::SwapValue( m_Header.Table );
+		}
+
+		if ( !m_Header.IsValid() )
+		{
+			return;
+		}
+
+		m_Deserializer.SetSizeEncoding( m_Header.Flags & SchemaHeader::VarintFlag ? SizeEncoding::Varint : SizeEncoding::Fixed );
+		m_Deserializer.SetChunkIndex( ( m_Header.Flags & SchemaHeader::ChunkIndexFlag ) != 0 );
+
+		Stream.Seek( m_Start + ( size_t )m_Header.Table );
+		m_Deserializer >> m_Sections;
+	}
+
+	StreamDeserializer< _Stream > m_Deserializer;
+	size_t                        m_Start;
+	SectionHeader                 m_Header;
+	std::vector< SectionEntry >   m_Sections;
+};
+
+// A section that is read from its SectionDeserializer the first time Get is called.
+template < typename T, typename _Stream >
+class LazySection
+{
+public:
+
+	template < typename _Key >
+	LazySection( SectionDeserializer< _Stream >& a_Sections, const _Key& a_Key )
+		: m_Sections( &a_Sections )
+		, m_Entry( a_Sections.Find( a_Key ) )
+		, m_Loaded( false )
+		, m_Value()
+	{ }
+
+	inline bool IsValid() const
+	{
+		return m_Entry && m_Entry->Schema == Serialization::SchemaHash< T >;
+	}
+
+	inline bool IsLoaded() const
+	{
+		return m_Loaded;
+	}
+
+	T& Get()
+	{
+		if ( !m_Loaded )
+		{
+			m_Sections->Read( m_Entry, m_Value );
+			m_Loaded = true;
+		}
+
+		return m_Value;
+	}
+
+private:
+
+	SectionDeserializer< _Stream >* m_Sections;
+	const SectionEntry*             m_Entry;
+	bool                            m_Loaded;
+	T                               m_Value;
+};
+
+typedef StreamSerializer  < FileStream   > FileSerializer;
+typedef StreamDeserializer< FileStream   > FileDeserializer;
+typedef StreamSerializer  < BufferStream > BufferSerializer;
+typedef StreamDeserializer< BufferStream > BufferDeserializer;
+typedef StreamDeserializer< ViewStream   > ViewDeserializer;
+typedef StreamSerializer  < MMapStream   > MMapSerializer;
+typedef StreamDeserializer< MMapStream   > MMapDeserializer;
+typedef StreamSerializer  < BufferedFileStream > BufferedFileSerializer;
+typedef StreamDeserializer< BufferedFileStream > BufferedFileDeserializer;
+typedef StreamSerializer  < GatherStream > GatherSerializer;
+typedef StreamDeserializer< GatherStream > GatherDeserializer;
+typedef StreamSerializer  < AsyncFileStream > AsyncFileSerializer;
+typedef StreamDeserializer< AsyncFileStream > AsyncFileDeserializer;
+typedef StreamSerializer  < CompressedStream< FileStream > > CompressedFileSerializer;
+typedef StreamDeserializer< CompressedStream< FileStream > > CompressedFileDeserializer;
+typedef SectionSerializer  < FileStream   > FileSectionSerializer;
+typedef SectionDeserializer< FileStream   > FileSectionDeserializer;
+typedef SectionSerializer  < BufferStream > BufferSectionSerializer;
+typedef SectionDeserializer< BufferStream > BufferSectionDeserializer;
+typedef SectionDeserializer< ViewStream   > ViewSectionDeserializer;
+typedef SectionSerializer  < MMapStream   > MMapSectionSerializer;
+typedef SectionDeserializer< MMapStream   > MMapSectionDeserializer;
+
+// Keeps returned BufferSerializers, and the memory of their buffers, for the next Acquire, so that encoding messages in a
+// steady state does not allocate. A pool is not thread safe: use Local() for a pool per thread, and return every lease
+// on the thread that acquired it, before that thread exits.
+class BufferPool
+{
+public:
+
+	static constexpr size_t DefaultMaxIdle = 16;
+	static constexpr size_t DefaultMaxCapacity = 16 * 1024 * 1024;
+
+	class Lease
+	{
+	public:
+
+		Lease()
+			: m_Pool( nullptr )
+		{ }
+
+		Lease( Lease&& a_Other ) noexcept
+			: m_Pool( a_Other.m_Pool )
+			, m_Serializer( std::move( a_Other.m_Serializer ) )
+		{ }
+
+		~Lease()
+		{
+			Return();
+		}
+
+		Lease& operator = ( Lease&& a_Other ) noexcept
+		{
+			if ( this != &a_Other )
+			{
+				Return();
+				m_Pool = a_Other.m_Pool;
+				m_Serializer = std::move( a_Other.m_Serializer );
+			}
+
+			return *this;
+		}
+
+		inline BufferSerializer& operator * () const
+		{
+			return *m_Serializer;
+		}
+
+		inline BufferSerializer* operator -> () const
+		{
+			return m_Serializer.get();
+		}
+
+		inline BufferStream& GetStream() const
+		{
+			return m_Serializer->GetStream();
+		}
+
+		// Hands the serializer back early. The lease is empty afterwards.
+		void Return()
+		{
+			if ( m_Serializer )
+			{
+				m_Pool->Return( std::move( m_Serializer ) );
+			}
+		}
+
+	private:
+
+		friend class BufferPool;
+
+		Lease( BufferPool* a_Pool, std::unique_ptr< BufferSerializer > a_Serializer )
+			: m_Pool( a_Pool )
+			, m_Serializer( std::move( a_Serializer ) )
+		{ }
+
+		BufferPool*                         m_Pool;
+		std::unique_ptr< BufferSerializer > m_Serializer;
+	};
+
+	// At most a_MaxIdle serializers are kept, and buffers that grew past a_MaxCapacity are freed instead of kept.
+	BufferPool( size_t a_MaxIdle = DefaultMaxIdle, size_t a_MaxCapacity = DefaultMaxCapacity )
+		: m_MaxIdle( a_MaxIdle )
+		, m_MaxCapacity( a_MaxCapacity )
+	{
+		m_Idle.reserve( a_MaxIdle );
+	}
+
+	static BufferPool& Local()
+	{
+		thread_local BufferPool Pool;
+		return Pool;
+	}
+
+	// Returns an empty, growable serializer with default settings.
+	Lease Acquire()
+	{
+		if ( m_Idle.empty() )
+		{
+			return Lease( this, std::unique_ptr< BufferSerializer >( new BufferSerializer() ) );
+		}
+
+		std::unique_ptr< BufferSerializer > Serializer = std::move( m_Idle.back() );
+		m_Idle.pop_back();
+		return Lease( this, std::move( Serializer ) );
+	}
+
+	inline size_t IdleCount() const
+	{
+		return m_Idle.size();
+	}
+
+	// Frees every idle serializer.
+	void Trim()
+	{
+		m_Idle.clear();
+	}
+
+private:
+
+	BufferPool( BufferPool&& ) = delete;
+
+	void Return( std::unique_ptr< BufferSerializer > a_Serializer )
+	{
+		if ( m_Idle.size() >= m_MaxIdle || a_Serializer->GetStream().Capacity() > m_MaxCapacity )
+		{
+			return;
+		}
+
+		a_Serializer->GetStream().Reset();
+		a_Serializer->SetSizeEncoding( SizeEncoding::Fixed );
+		a_Serializer->SetByteOrder( ByteOrder::Native );
+		a_Serializer->SetParallelism( 1 );
+		a_Serializer->SetChunkIndex( 0 );
+		m_Idle.push_back( std::move( a_Serializer ) );
+	}
+
+	size_t                                             m_MaxIdle;
+	size_t                                             m_MaxCapacity;
+	std::vector< std::unique_ptr< BufferSerializer > > m_Idle;
+};
+
+template < typename T >
+class Span
+{
+public:
+
+	using element_type = T;
+	using value_type   = std::remove_cv_t< T >;
+	using size_type    = size_t;
+	using iterator     = T*;
+
+	Span()
+		: m_Data( nullptr )
+		, m_Size( 0 )
 	{ }
 
-	template < typename... Args >
-	inline void Open( Args&&... a_Args )
+	Span( T* a_Data, size_t a_Size )
+		: m_Data( a_Data )
+		, m_Size( a_Size )
+	{ }
+
+	template < typename _Container >
+	Span( _Container& a_Container )
+		: m_Data( a_Container.data() )
+		, m_Size( a_Container.size() )
+	{ }
+
+	inline T* data() const
+	{
+		return m_Data;
+	}
+
+	inline size_t size() const
+	{
+		return m_Size;
+	}
+
+	inline bool empty() const
+	{
+		return m_Size == 0;
+	}
+
+	inline T* begin() const
+	{
+		return m_Data;
+	}
+
+	inline T* end() const
+	{
+		return m_Data + m_Size;
+	}
+
+	inline T& operator[]( size_t a_Index ) const
+	{
+		return m_Data[ a_Index ];
+	}
+
+private:
+
+	T*     m_Data;
+	size_t m_Size;
+};
+
+template < typename >
+class Serializer;
+
+template < typename >
+class Deserializer;
+
+template < typename... Args >
+class Serializer< std::pair< Args... > >
+{
+	using Type = std::pair< Args... >;
+
+public:
+
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
+
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SchemaHashOfAll< Args... >( Serialization::HashName( "tuple" ) );
+	}
+
+	template < SizeEncoding _Encoding >
+	static constexpr size_t FixedSizeOf()
+	{
+		return Serialization::FixedSizeOfAll< _Encoding, Args... >();
+	}
+
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
+	{
+		a_Serializer << m_Serializable->first << m_Serializable->second;
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer& m_Serializable->first& m_Serializable->second;
+	}
+
+	const Type* m_Serializable;
+};
+
+template < typename... Args >
+class Deserializer< std::pair< Args... > >
+{
+	using Type = std::pair< Args... >;
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		a_Deserializer >> m_Deserializable->first >> m_Deserializable->second;
+	}
+
+	Type* m_Deserializable;
+};
+
+template < typename... Args >
+class Serializer< std::tuple< Args... > >
+{
+	using Type = std::tuple< Args... >;
+
+public:
+
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
+
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	static constexpr uint64_t SchemaHash()
 	{
-		m_Stream.Open( std::forward< Args >( a_Args )... );
+		return Serialization::SchemaHashOfAll< Args... >( Serialization::HashName( "tuple" ) );
 	}
 
-	inline void Close()
+	template < SizeEncoding _Encoding >
+	static constexpr size_t FixedSizeOf()
 	{
-		m_Stream.Close();
+		return Serialization::FixedSizeOfAll< _Encoding, Args... >();
 	}
 
-	template < typename T >
-	_This& operator << ( const T& a_Serializable )
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		Serialization::Serialize( a_Serializable, *this );
-		return *this;
+		std::apply( [ & ]( const auto&... a_Elements )
+		{
+			( void )( a_Serializer << ... << a_Elements );
+		}, *m_Serializable );
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		std::apply( [ & ]( const auto&... a_Elements )
+		{
+			( void )( a_Sizer & ... & a_Elements );
+		}, *m_Serializable );
 	}
 
+	const Type* m_Serializable;
+};
+
+template < typename... Args >
+class Deserializer< std::tuple< Args... > >
+{
+	using Type = std::tuple< Args... >;
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
+
 private:
 
-	template < typename > friend class Serializer;
+	friend class Serialization;
 
-	StreamSerializer( StreamSerializer&& ) = delete;
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		std::apply( [ & ]( auto&... a_Elements )
+		{
+			( void )( a_Deserializer >> ... >> a_Elements );
+		}, *m_Deserializable );
+	}
 
-	_Stream m_Stream;
+	Type* m_Deserializable;
 };
 
-template < typename _Stream >
-class StreamDeserializer
+template < typename T, size_t _Size >
+class Serializer< T( * )[ _Size ] >
 {
-	typedef _Stream                       _Base;
-	typedef StreamDeserializer< _Stream > _This;
+	using Type = T( * )[ _Size ];
 
 public:
 
-	template < typename... Args >
-	StreamDeserializer( Args&&... a_Args )
-		: m_Stream( std::forward< Args >( a_Args )... )
-	{ }
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
 
-	template < typename... Args >
-	inline void Open( Args&&... a_Args )
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	static constexpr uint64_t SchemaHash()
 	{
-		m_Stream.Open( std::forward< Args >( a_Args )... );
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< T > );
 	}
 
-	inline void Close()
+	template < SizeEncoding _Encoding >
+	static constexpr size_t FixedSizeOf()
 	{
-		m_Stream.Close();
+		constexpr size_t Element = Serialization::FixedSizeOf< T, _Encoding >;
+		return Element == Serialization::VariableSize ? Serialization::VariableSize : Serialization::SizeOfSizePrefix( _Size, _Encoding ) + _Size * Element;
 	}
 
-	template < typename T >
-	_This& operator >> ( T& a_Deserializable )
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		Serialization::Deserialize( a_Deserializable, *this );
-		return *this;
+		a_Serializer.WriteSizePrefix( _Size );
+
+		if constexpr ( Serialization::IsTriviallySerializable< T > )
+		{
+			a_Serializer.WriteValues( **m_Serializable, _Size );
+		}
+		else
+		{
+			for ( size_t i = 0; i < _Size; ++i )
+			{
+				a_Serializer << ( **m_Serializable )[ i ];
+			}
+		}
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer.AddSizePrefix( _Size );
+
+		for ( size_t i = 0; i < _Size; ++i )
+		{
+			a_Sizer& ( **m_Serializable )[ i ];
+		}
 	}
 
+	const Type* m_Serializable;
+};
+
+template < typename T, size_t _Size >
+class Deserializer< T( * )[ _Size ] >
+{
+	using Type = T( * )[ _Size ];
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
+
 private:
 
-	template < typename > friend class Deserializer;
+	friend class Serialization;
 
-	StreamDeserializer( StreamDeserializer&& ) = delete;
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		Size = Size > _Size ? _Size : Size;
 
-	_Stream m_Stream;
+		if constexpr ( Serialization::IsTriviallySerializable< T > )
+		{
+			a_Deserializer.ReadValues( **m_Deserializable, Size );
+		}
+		else
+		{
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				a_Deserializer >> ( **m_Deserializable )[ i ];
+			}
+		}
+	}
+
+	Type* m_Deserializable;
 };
 
-class StreamSizer
+template < typename... Args >
+class Serializer< std::basic_string< Args... > >
 {
+	using Type = std::basic_string< Args... >;
+
 public:
 
-	StreamSizer()
-		: m_Size( 0 )
-	{ }
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
 
-	template < typename T >
-	StreamSizer& operator &( const T& a_Object )
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	static constexpr uint64_t SchemaHash()
 	{
-		Serialization::SizeOf( a_Object, *this );
-		return *this;
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
 	}
 
-	StreamSizer& operator +=( size_t a_Size )
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		m_Size += a_Size;
-		return *this;
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+		a_Serializer.WriteValues( m_Serializable->data(), m_Serializable->size() );
 	}
 
-	operator size_t () const
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		return m_Size;
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+		a_Sizer += sizeof( typename Type::value_type ) * m_Serializable->size();
 	}
 
+	const Type* m_Serializable;
+};
+
+template < typename... Args >
+class Deserializer< std::basic_string< Args... > >
+{
+	using Type = std::basic_string< Args... >;
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
+
 private:
 
-	size_t m_Size;
+	friend class Serialization;
+
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		m_Deserializable->resize( Size );
+		a_Deserializer.ReadValues( m_Deserializable->data(), Size );
+	}
+
+	Type* m_Deserializable;
+};
+
+template < typename... Args >
+class Serializer< std::basic_string_view< Args... > >
+{
+	using Type = std::basic_string_view< Args... >;
+
+public:
+
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
+
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
+	{
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+		a_Serializer.WriteValues( m_Serializable->data(), m_Serializable->size() );
+	}
+
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
+	{
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+		a_Sizer += sizeof( typename Type::value_type ) * m_Serializable->size();
+	}
+
+	const Type* m_Serializable;
+};
+
+template < typename... Args >
+class Deserializer< std::basic_string_view< Args... > >
+{
+	using Type = std::basic_string_view< Args... >;
+
+public:
+
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
+
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
+
+private:
+
+	friend class Serialization;
+
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	{
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		SERIALIZATION_CHECK( sizeof( typename Type::value_type ) == 1 || !a_Deserializer.IsSwapping(), "A view cannot be byte swapped." );
+		auto Data = a_Deserializer.m_Stream.View( sizeof( typename Type::value_type ) * Size );
+		*m_Deserializable = Type( ( const typename Type::value_type* )Data, Size );
+	}
+
+	Type* m_Deserializable;
 };
 
 template < typename T >
-class Serializer
+class Serializer< Span< T > >
 {
-	using Type = T;
+	using Type = Span< T >;
 
 public:
 
 	Serializer( const Type& a_Serializable )
 		: m_Serializable( &a_Serializable )
-	{ }
+	{}
 
 	Serializer( const Type* a_Serializable )
 		: m_Serializable( a_Serializable )
-	{ }
+	{}
 
 private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< T > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer.m_Stream.Write( m_Serializable, sizeof( Type ) );
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+
+		if constexpr ( Serialization::IsTriviallySerializable< typename Type::value_type > )
+		{
+			a_Serializer.WriteValues( m_Serializable->data(), m_Serializable->size() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Serializer << Element;
+			}
+		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( T );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
+		{
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
+		}
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename T >
-class Deserializer
+class Deserializer< Span< T > >
 {
-	using Type = T;
+	using Type = Span< T >;
 
 public:
 
 	Deserializer( Type& a_Deserializable )
 		: m_Deserializable( &a_Deserializable )
-	{ }
+	{}
 
 	Deserializer( Type* a_Deserializable )
 		: m_Deserializable( a_Deserializable )
-	{ }
+	{}
 
 private:
 
 	friend class Serialization;
 
+	// The view is only as aligned as its position in the stream, so elements must have been written at an offset that
+	// is a multiple of their alignment.
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		a_Deserializer.m_Stream.Read( m_Deserializable, sizeof( Type ) );
+		static_assert( std::is_const_v< T > && Serialization::IsTriviallySerializable< typename Type::value_type >,
+			"Only spans of const, trivially serializable elements can be deserialized as views into the stream." );
+
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		SERIALIZATION_CHECK( !Serialization::IsSwappable< std::remove_cv_t< T > > || !a_Deserializer.IsSwapping(), "A view cannot be byte swapped." );
+		auto Data = a_Deserializer.m_Stream.View( sizeof( T ) * Size );
+		SERIALIZATION_CHECK( !Size || ( uintptr_t )Data % alignof( T ) == 0, "A view is not aligned for its element type." );
+		*m_Deserializable = Type( ( T* )Data, Size );
 	}
 
 	Type* m_Deserializable;
 };
 
-class FileStream
+template < typename T, size_t _Size >
+class Serializer< std::array< T, _Size > >
 {
-public:
+	using Type = std::array< T, _Size >;
 
-	FileStream()
-		: m_File( nullptr )
-	{ }
+public:
 
-	FileStream( const char* a_Path )
-	{
-		Open( a_Path );
-	}
+	Serializer( const Type& a_Serializable )
+		: m_Serializable( &a_Serializable )
+	{}
 
-	~FileStream()
-	{
-		Close();
-	}
+	Serializer( const Type* a_Serializable )
+		: m_Serializable( a_Serializable )
+	{}
 
-	inline void Open( const char* a_Path )
-	{
-		if ( m_File )
-		{
-			Close();
-		}
+private:
 
-		fopen_s( &m_File, a_Path, "rb+" );
-		_ASSERT_EXPR( m_File, "File does not exist." );
-	}
+	friend class Serialization;
 
-	inline void Close()
+	static constexpr uint64_t SchemaHash()
 	{
-		if ( !m_File )
-		{
-			return;
-		}
-
-		fclose( m_File );
-		m_File = nullptr;
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< T > );
 	}
 
-	inline void Write( const void* a_From, size_t a_Size )
+	template < SizeEncoding _Encoding >
+	static constexpr size_t FixedSizeOf()
 	{
-		fwrite( a_From, 1, a_Size, m_File );
+		constexpr size_t Element = Serialization::FixedSizeOf< T, _Encoding >;
+		return Element == Serialization::VariableSize ? Serialization::VariableSize : Serialization::SizeOfSizePrefix( _Size, _Encoding ) + _Size * Element;
 	}
 
-	inline void Read( void* a_To, size_t a_Size )
+	template < typename _StreamSerializer >
+	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		fread( a_To, 1, a_Size, m_File );
-	}
+		a_Serializer.WriteSizePrefix( _Size );
 
-	inline void Seek( size_t a_Position )
-	{
-		fseek( m_File, a_Position, SEEK_SET );
+		if constexpr ( Serialization::IsTriviallySerializable< T > )
+		{
+			a_Serializer.WriteValues( m_Serializable->data(), _Size );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Serializer << Element;
+			}
+		}
 	}
 
-	inline bool End() const
+	template < typename _Sizer >
+	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		return feof( m_File );
-	}
+		a_Sizer.AddSizePrefix( _Size );
 
-	inline size_t Size() const
-	{
-		if ( !m_File )
+		for ( auto& Element : *m_Serializable )
 		{
-			return 0;
+			a_Sizer& Element;
 		}
-
-		size_t Position = ftell( m_File );
-		fseek( m_File, 0, SEEK_END );
-		size_t Size = ftell( m_File );
-		fseek( m_File, Position, SEEK_SET );
-		return Size;
 	}
 
-private:
-
-	template < typename > friend class Serializer;
-	template < typename > friend class Deserializer;
-
-	FILE* m_File;
+	const Type* m_Serializable;
 };
 
-class BufferStream
+template < typename T, size_t _Size >
+class Deserializer< std::array< T, _Size > >
 {
-public:
-
-	BufferStream()
-		: m_Data( nullptr )
-		, m_Head( nullptr )
-		, m_Size( 0 )
-	{ }
-
-	BufferStream( size_t a_Size )
-		: m_Data( ( uint8_t* )malloc( a_Size ) )
-		, m_Head( m_Data )
-		, m_Size( a_Size )
-	{ }
-
-	~BufferStream()
-	{
-		Close();
-	}
-
-	void Open( size_t a_Size )
-	{
-		if ( m_Data )
-		{
-			Close();
-		}
+	using Type = std::array< T, _Size >;
 
-		m_Data = ( uint8_t* )malloc( a_Size );
-		m_Head = m_Data;
-		m_Size = a_Size;
-	}
+public:
 
-	void Close()
-	{
-		delete[] m_Data;
-		m_Data = nullptr;
-		m_Head = nullptr;
-		m_Size = 0;
-	}
+	Deserializer( Type& a_Deserializable )
+		: m_Deserializable( &a_Deserializable )
+	{}
 
-	inline void Write( const void* a_From, size_t a_Size )
-	{
-		memcpy( m_Head, a_From, a_Size );
-		m_Head += a_Size;
-	}
+	Deserializer( Type* a_Deserializable )
+		: m_Deserializable( a_Deserializable )
+	{}
 
-	inline void Read( void* a_To, size_t a_Size )
-	{
-		memcpy( a_To, m_Head, a_Size );
-		m_Head += a_Size;
-	}
+private:
 
-	inline void Seek( size_t a_Position )
-	{
-		m_Head = m_Data + a_Position;
-	}
+	friend class Serialization;
 
-	inline bool End() const
+	template < typename _StreamDeserializer >
+	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		return m_Head - m_Data == m_Size;
-	}
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		Size = Size > _Size ? _Size : Size;
 
-	inline size_t Size() const
-	{
-		return m_Size;
+		if constexpr ( Serialization::IsTriviallySerializable< T > )
+		{
+			a_Deserializer.ReadValues( m_Deserializable->data(), Size );
+		}
+		else
+		{
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				a_Deserializer >> m_Deserializable->at( i );
+			}
+		}
 	}
 
-private:
-
-	uint8_t* m_Data;
-	uint8_t* m_Head;
-	size_t   m_Size;
+	Type* m_Deserializable;
 };
 
-typedef StreamSerializer  < FileStream   > FileSerializer;
-typedef StreamDeserializer< FileStream   > FileDeserializer;
-typedef StreamSerializer  < BufferStream > BufferSerializer;
-typedef StreamDeserializer< BufferStream > BufferDeserializer;
-
-template < typename >
-class Serializer;
-
-template < typename >
-class Deserializer;
-
 template < typename... Args >
-class Serializer< std::pair< Args... > >
+class Serializer< std::vector< Args... > >
 {
-	using Type = std::pair< Args... >;
+	using Type = std::vector< Args... >;
 
 public:
 
@@ -577,25 +5928,48 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type >, !Serialization::IsTriviallySerializable< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->first << m_Serializable->second;
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+
+		if constexpr ( Serialization::IsTriviallySerializable< typename Type::value_type > )
+		{
+			a_Serializer.WriteValues( m_Serializable->data(), m_Serializable->size() );
+		}
+		else
+		{
+			Serialization::SerializeRange( a_Serializer, m_Serializable->begin(), m_Serializable->size() );
+		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer& m_Serializable->first& m_Serializable->second;
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+
+		if constexpr ( Serialization::IsTriviallySerializable< typename Type::value_type > )
+		{
+			a_Sizer += m_Serializable->size() * sizeof( typename Type::value_type );
+		}
+		else
+		{
+			Serialization::SizeOfRange( a_Sizer, m_Serializable->begin(), m_Serializable->size() );
+		}
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::pair< Args... > >
+class Deserializer< std::vector< Args... > >
 {
-	using Type = std::pair< Args... >;
+	using Type = std::vector< Args... >;
 
 public:
 
@@ -614,16 +5988,44 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		a_Deserializer >> m_Deserializable->first >> m_Deserializable->second;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		m_Deserializable->resize( Size );
+
+		if constexpr ( Serialization::IsTriviallySerializable< typename Type::value_type > )
+		{
+			a_Deserializer.ReadValues( m_Deserializable->data(), Size );
+		}
+		else
+		{
+			std::vector< size_t > Offsets;
+
+			if ( Serialization::ReadChunkIndex( a_Deserializer, Offsets ) )
+			{
+				Serialization::DeserializeChunks( a_Deserializer, Offsets, Size, [ this ]( auto& a_Part, size_t a_Begin, size_t a_End )
+				{
+					for ( size_t i = a_Begin; i < a_End; ++i )
+					{
+						a_Part >> ( *m_Deserializable )[ i ];
+					}
+				} );
+			}
+			else
+			{
+				for ( auto& Element : *m_Deserializable )
+				{
+					a_Deserializer >> Element;
+				}
+			}
+		}
 	}
 
 	Type* m_Deserializable;
 };
 
 template < typename... Args >
-class Serializer< std::tuple< Args... > >
+class Serializer< std::deque< Args... > >
 {
-	using Type = std::tuple< Args... >;
+	using Type = std::deque< Args... >;
 
 public:
 
@@ -639,41 +6041,33 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type >, true );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		if constexpr ( sizeof...( Args ) > 0 )
-		{
-			a_Serializer << m_Serializable->_Myfirst._Val;
-		}
-
-		if constexpr ( sizeof...( Args ) > 1 )
-		{
-			a_Serializer << m_Serializable->_Get_rest();
-		}
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+		Serialization::SerializeRange( a_Serializer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		if constexpr ( sizeof...( Args ) > 0 )
-		{
-			a_Sizer& m_Serializable->_Myfirst._Val;
-		}
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		if constexpr ( sizeof...( Args ) > 1 )
-		{
-			a_Sizer& m_Serializable->_Get_rest();
-		}
+		Serialization::SizeOfRange( a_Sizer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::tuple< Args... > >
+class Deserializer< std::deque< Args... > >
 {
-	using Type = std::tuple< Args... >;
+	using Type = std::deque< Args... >;
 
 public:
 
@@ -692,24 +6086,38 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		if constexpr ( sizeof...( Args ) > 0 )
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		size_t Offset = m_Deserializable->size();
+		m_Deserializable->resize( Offset + Size );
+
+		std::vector< size_t > Offsets;
+
+		if ( Serialization::ReadChunkIndex( a_Deserializer, Offsets ) )
 		{
-			a_Deserializer >> m_Deserializable->_Myfirst._Val;
+			Serialization::DeserializeChunks( a_Deserializer, Offsets, Size, [ this, Offset ]( auto& a_Part, size_t a_Begin, size_t a_End )
+			{
+				for ( auto Iterator = m_Deserializable->begin() + Offset + a_Begin; Iterator != m_Deserializable->begin() + Offset + a_End; ++Iterator )
+				{
+					a_Part >> *Iterator;
+				}
+			} );
 		}
-
-		if constexpr ( sizeof...( Args ) > 1 )
+		else
 		{
-			a_Deserializer >> m_Deserializable->_Get_rest();
+			for ( auto Iterator = m_Deserializable->begin() + Offset; Iterator != m_Deserializable->end(); ++Iterator )
+			{
+				a_Deserializer >> *Iterator;
+			}
 		}
 	}
 
 	Type* m_Deserializable;
 };
 
-template < typename T, size_t _Size >
-class Serializer< T( * )[ _Size ] >
+template < typename... Args >
+class Serializer< std::forward_list< Args... > >
 {
-	using Type = T( * )[ _Size ];
+	using Type = std::forward_list< Args... >;
 
 public:
 
@@ -725,35 +6133,48 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << _Size;
+		a_Serializer.WriteSizePrefix( std::distance( m_Serializable->begin(), m_Serializable->end() ) );
 
-		for ( size_t i = 0; i < _Size; ++i )
+		for ( auto& Element : *m_Serializable )
 		{
-			a_Serializer << ( *m_Serializable )[ i ];
+			a_Serializer << Element;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		size_t Size = std::distance( m_Serializable->begin(), m_Serializable->end() );
+		a_Sizer.AddSizePrefix( Size );
 
-		for ( size_t i = 0; i < _Size; ++i )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
+		{
+			a_Sizer += Size * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
 		{
-			a_Sizer& ( *m_Serializable )[ i ];
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
 	const Type* m_Serializable;
 };
 
-template < typename T, size_t _Size >
-class Deserializer< T( * )[ _Size ] >
+template < typename... Args >
+class Deserializer< std::forward_list< Args... > >
 {
-	using Type = T( * )[ _Size ];
+	using Type = std::forward_list< Args... >;
 
 public:
 
@@ -772,13 +6193,18 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-		Size = Size > _Size ? _Size : Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		auto Iterator = m_Deserializable->before_begin();
+
+		while ( std::next( Iterator ) != m_Deserializable->end() )
+		{
+			++Iterator;
+		}
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			a_Deserializer >> ( *m_Deserializable )[ i ];
+			Iterator = m_Deserializable->emplace_after( Iterator );
+			a_Deserializer >> *Iterator;
 		}
 	}
 
@@ -786,9 +6212,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::basic_string< Args... > >
+class Serializer< std::list< Args... > >
 {
-	using Type = std::basic_string< Args... >;
+	using Type = std::list< Args... >;
 
 public:
 
@@ -804,27 +6230,47 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
-		a_Serializer.m_Stream.Write( m_Serializable->data(), sizeof( typename Type::value_type ) * m_Serializable->size() );
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+
+		for ( auto& Element : *m_Serializable )
+		{
+			a_Serializer << Element;
+		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
-		a_Sizer += sizeof( typename Type::value_type ) * m_Serializable->size();
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
+		{
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
+		}
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::basic_string< Args... > >
+class Deserializer< std::list< Args... > >
 {
-	using Type = std::basic_string< Args... >;
+	using Type = std::list< Args... >;
 
 public:
 
@@ -843,19 +6289,21 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-		m_Deserializable->resize( Size );
-		a_Deserializer.m_Stream.Read( m_Deserializable->data(), sizeof( typename Type::value_type ) * Size );
+		size_t Size = a_Deserializer.ReadSizePrefix();
+
+		for ( size_t i = 0; i < Size; ++i )
+		{
+			a_Deserializer >> m_Deserializable->emplace_back();
+		}
 	}
 
 	Type* m_Deserializable;
 };
 
-template < typename T, size_t _Size >
-class Serializer< std::array< T, _Size > >
+template < typename... Args >
+class Serializer< std::map< Args... > >
 {
-	using Type = std::array< T, _Size >;
+	using Type = std::map< Args... >;
 
 public:
 
@@ -871,35 +6319,33 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type >, true );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << _Size;
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Serializer << Element;
-		}
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
+		Serialization::SerializeRange( a_Serializer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Sizer& Element;
-		}
+		Serialization::SizeOfRange( a_Sizer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	const Type* m_Serializable;
 };
 
-template < typename T, size_t _Size >
-class Deserializer< std::array< T, _Size > >
+template < typename... Args >
+class Deserializer< std::map< Args... > >
 {
-	using Type = std::array< T, _Size >;
+	using Type = std::map< Args... >;
 
 public:
 
@@ -918,13 +6364,43 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-		Size = Size > _Size ? _Size : Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		std::vector< size_t > Offsets;
 
-		for ( size_t i = 0; i < Size; ++i )
+		if ( Serialization::ReadChunkIndex( a_Deserializer, Offsets ) )
+		{
+			std::vector< std::pair< typename Type::key_type, typename Type::mapped_type > > Pairs;
+			Pairs.reserve( Size );
+
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				Pairs.emplace_back(
+					Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() ),
+					Serialization::Construct< typename Type::mapped_type >( m_Deserializable->get_allocator() ) );
+			}
+
+			Serialization::DeserializeChunks( a_Deserializer, Offsets, Size, [ &Pairs ]( auto& a_Part, size_t a_Begin, size_t a_End )
+			{
+				for ( size_t i = a_Begin; i < a_End; ++i )
+				{
+					a_Part >> Pairs[ i ].first >> Pairs[ i ].second;
+				}
+			} );
+
+			for ( auto& Pair : Pairs )
+			{
+				m_Deserializable->try_emplace( m_Deserializable->end(), std::move( Pair.first ), std::move( Pair.second ) );
+			}
+		}
+		else
 		{
-			a_Deserializer >> m_Deserializable->at( i );
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				typename Type::key_type Key = Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() );
+				a_Deserializer >> Key;
+				auto Iterator = m_Deserializable->try_emplace( m_Deserializable->end(), std::move( Key ) );
+				a_Deserializer >> Iterator->second;
+			}
 		}
 	}
 
@@ -932,9 +6408,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::vector< Args... > >
+class Serializer< std::multimap< Args... > >
 {
-	using Type = std::vector< Args... >;
+	using Type = std::multimap< Args... >;
 
 public:
 
@@ -950,25 +6426,37 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		for ( auto& Pair : *m_Serializable )
 		{
-			a_Serializer << Element;
+			a_Serializer << Pair;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -976,9 +6464,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::vector< Args... > >
+class Deserializer< std::multimap< Args... > >
 {
-	using Type = std::vector< Args... >;
+	using Type = std::multimap< Args... >;
 
 public:
 
@@ -997,13 +6485,14 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-		m_Deserializable->resize( Size );
+		size_t Size = a_Deserializer.ReadSizePrefix();
 
-		for ( auto& Element : *m_Deserializable )
+		for ( size_t i = 0; i < Size; ++i )
 		{
-			a_Deserializer >> Element;
+			typename Type::key_type Key = Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Key;
+			auto Iterator = m_Deserializable->emplace_hint( m_Deserializable->end(), std::piecewise_construct, std::forward_as_tuple( std::move( Key ) ), std::forward_as_tuple() );
+			a_Deserializer >> Iterator->second;
 		}
 	}
 
@@ -1011,9 +6500,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::deque< Args... > >
+class Serializer< std::unordered_map< Args... > >
 {
-	using Type = std::deque< Args... >;
+	using Type = std::unordered_map< Args... >;
 
 public:
 
@@ -1029,34 +6518,34 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type >, true );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Serializer << Element;
-		}
+		Serialization::SerializeRange( a_Serializer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Sizer& Element;
-		}
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
+
+		Serialization::SizeOfRange( a_Sizer, m_Serializable->begin(), m_Serializable->size() );
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::deque< Args... > >
+class Deserializer< std::unordered_map< Args... > >
 {
-	using Type = std::deque< Args... >;
+	using Type = std::unordered_map< Args... >;
 
 public:
 
@@ -1075,12 +6564,46 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
 
-		for ( size_t i = 0; i < Size; ++i )
+		m_Deserializable->reserve( m_Deserializable->size() + Size );
+
+		std::vector< size_t > Offsets;
+
+		if ( Serialization::ReadChunkIndex( a_Deserializer, Offsets ) )
 		{
-			a_Deserializer >> m_Deserializable->emplace_back();
+			std::vector< std::pair< typename Type::key_type, typename Type::mapped_type > > Pairs;
+			Pairs.reserve( Size );
+
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				Pairs.emplace_back(
+					Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() ),
+					Serialization::Construct< typename Type::mapped_type >( m_Deserializable->get_allocator() ) );
+			}
+
+			Serialization::DeserializeChunks( a_Deserializer, Offsets, Size, [ &Pairs ]( auto& a_Part, size_t a_Begin, size_t a_End )
+			{
+				for ( size_t i = a_Begin; i < a_End; ++i )
+				{
+					a_Part >> Pairs[ i ].first >> Pairs[ i ].second;
+				}
+			} );
+
+			for ( auto& Pair : Pairs )
+			{
+				m_Deserializable->try_emplace( std::move( Pair.first ), std::move( Pair.second ) );
+			}
+		}
+		else
+		{
+			for ( size_t i = 0; i < Size; ++i )
+			{
+				typename Type::key_type Key = Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() );
+				a_Deserializer >> Key;
+				auto Iterator = m_Deserializable->try_emplace( std::move( Key ) ).first;
+				a_Deserializer >> Iterator->second;
+			}
 		}
 	}
 
@@ -1088,9 +6611,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::forward_list< Args... > >
+class Serializer< std::unordered_multimap< Args... > >
 {
-	using Type = std::forward_list< Args... >;
+	using Type = std::unordered_multimap< Args... >;
 
 public:
 
@@ -1106,25 +6629,37 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		for ( auto& Pair : *m_Serializable )
 		{
-			a_Serializer << Element;
+			a_Serializer << Pair;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -1132,9 +6667,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::forward_list< Args... > >
+class Deserializer< std::unordered_multimap< Args... > >
 {
-	using Type = std::forward_list< Args... >;
+	using Type = std::unordered_multimap< Args... >;
 
 public:
 
@@ -1153,12 +6688,16 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+
+		m_Deserializable->reserve( m_Deserializable->size() + Size );
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			a_Deserializer >> m_Deserializable->emplace_back();
+			typename Type::key_type Key = Serialization::Construct< typename Type::key_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Key;
+			auto Iterator = m_Deserializable->emplace( std::piecewise_construct, std::forward_as_tuple( std::move( Key ) ), std::forward_as_tuple() );
+			a_Deserializer >> Iterator->second;
 		}
 	}
 
@@ -1166,9 +6705,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::list< Args... > >
+class Serializer< std::set< Args... > >
 {
-	using Type = std::list< Args... >;
+	using Type = std::set< Args... >;
 
 public:
 
@@ -1184,10 +6723,15 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
 		for ( auto& Element : *m_Serializable )
 		{
@@ -1198,11 +6742,18 @@ private:
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -1210,9 +6761,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::list< Args... > >
+class Deserializer< std::set< Args... > >
 {
-	using Type = std::list< Args... >;
+	using Type = std::set< Args... >;
 
 public:
 
@@ -1231,12 +6782,13 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			a_Deserializer >> m_Deserializable->emplace_back();
+			typename Type::value_type Value = Serialization::Construct< typename Type::value_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Value;
+			m_Deserializable->emplace_hint( m_Deserializable->end(), std::move( Value ) );
 		}
 	}
 
@@ -1244,9 +6796,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::map< Args... > >
+class Serializer< std::multiset< Args... > >
 {
-	using Type = std::map< Args... >;
+	using Type = std::multiset< Args... >;
 
 public:
 
@@ -1262,25 +6814,37 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Pair : *m_Serializable )
+		for ( auto& Element : *m_Serializable )
 		{
-			a_Serializer << Pair;
+			a_Serializer << Element;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -1288,9 +6852,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::map< Args... > >
+class Deserializer< std::multiset< Args... > >
 {
-	using Type = std::map< Args... >;
+	using Type = std::multiset< Args... >;
 
 public:
 
@@ -1309,14 +6873,13 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			typename Type::key_type Key;
-			a_Deserializer >> Key;
-			a_Deserializer >> ( *m_Deserializable )[ Key ];
+			typename Type::value_type Value = Serialization::Construct< typename Type::value_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Value;
+			m_Deserializable->emplace_hint( m_Deserializable->end(), std::move( Value ) );
 		}
 	}
 
@@ -1324,9 +6887,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::multimap< Args... > >
+class Serializer< std::unordered_set< Args... > >
 {
-	using Type = std::multimap< Args... >;
+	using Type = std::unordered_set< Args... >;
 
 public:
 
@@ -1342,25 +6905,37 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Pair : *m_Serializable )
+		for ( auto& Element : *m_Serializable )
 		{
-			a_Serializer << Pair;
+			a_Serializer << Element;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -1368,9 +6943,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::multimap< Args... > >
+class Deserializer< std::unordered_set< Args... > >
 {
-	using Type = std::multimap< Args... >;
+	using Type = std::unordered_set< Args... >;
 
 public:
 
@@ -1389,14 +6964,15 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+
+		m_Deserializable->reserve( m_Deserializable->size() + Size );
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			typename Type::key_type Key;
-			a_Deserializer >> Key;
-			a_Deserializer >> ( *m_Deserializable )[ Key ];
+			typename Type::value_type Value = Serialization::Construct< typename Type::value_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Value;
+			m_Deserializable->emplace( std::move( Value ) );
 		}
 	}
 
@@ -1404,9 +6980,9 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::unordered_map< Args... > >
+class Serializer< std::unordered_multiset< Args... > >
 {
-	using Type = std::unordered_map< Args... >;
+	using Type = std::unordered_multiset< Args... >;
 
 public:
 
@@ -1422,25 +6998,37 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SequenceSchemaHash( Serialization::SchemaHash< typename Type::value_type > );
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
+		a_Serializer.WriteSizePrefix( m_Serializable->size() );
 
-		for ( auto& Pair : *m_Serializable )
+		for ( auto& Element : *m_Serializable )
 		{
-			a_Serializer << Pair;
+			a_Serializer << Element;
 		}
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
+		a_Sizer.AddSizePrefix( m_Serializable->size() );
 
-		for ( auto& Element : *m_Serializable )
+		if constexpr ( Serialization::HasFixedSize< typename Type::value_type > )
 		{
-			a_Sizer& Element;
+			a_Sizer += m_Serializable->size() * Serialization::GetFixedSizeOf< typename Type::value_type >( a_Sizer.GetSizeEncoding() );
+		}
+		else
+		{
+			for ( auto& Element : *m_Serializable )
+			{
+				a_Sizer& Element;
+			}
 		}
 	}
 
@@ -1448,9 +7036,9 @@ private:
 };
 
 template < typename... Args >
-class Deserializer< std::unordered_map< Args... > >
+class Deserializer< std::unordered_multiset< Args... > >
 {
-	using Type = std::unordered_map< Args... >;
+	using Type = std::unordered_multiset< Args... >;
 
 public:
 
@@ -1469,14 +7057,15 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Size = a_Deserializer.ReadSizePrefix();
+
+		m_Deserializable->reserve( m_Deserializable->size() + Size );
 
 		for ( size_t i = 0; i < Size; ++i )
 		{
-			typename Type::key_type Key;
-			a_Deserializer >> Key;
-			a_Deserializer >> ( *m_Deserializable )[ Key ];
+			typename Type::value_type Value = Serialization::Construct< typename Type::value_type >( m_Deserializable->get_allocator() );
+			a_Deserializer >> Value;
+			m_Deserializable->emplace( std::move( Value ) );
 		}
 	}
 
@@ -1484,9 +7073,17 @@ private:
 };
 
 template < typename... Args >
-class Serializer< std::unordered_multimap< Args... > >
+class Serializer< std::stack< Args... > >
 {
-	using Type = std::unordered_multimap< Args... >;
+	using Type = std::stack< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container() const
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1502,35 +7099,38 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SchemaHash< typename Type::container_type >;
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
-
-		for ( auto& Pair : *m_Serializable )
-		{
-			a_Serializer << Pair;
-		}
+		a_Serializer << reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Sizer& Element;
-		}
+		a_Sizer& reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::unordered_multimap< Args... > >
+class Deserializer< std::stack< Args... > >
 {
-	using Type = std::unordered_multimap< Args... >;
+	using Type = std::stack< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container()
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1549,24 +7149,24 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-
-		for ( size_t i = 0; i < Size; ++i )
-		{
-			typename Type::key_type Key;
-			a_Deserializer >> Key;
-			a_Deserializer >> ( *m_Deserializable )[ Key ];
-		}
+		a_Deserializer >> reinterpret_cast< Access* >( m_Deserializable )->_Get_Container();
 	}
 
 	Type* m_Deserializable;
 };
 
 template < typename... Args >
-class Serializer< std::set< Args... > >
+class Serializer< std::queue< Args... > >
 {
-	using Type = std::set< Args... >;
+	using Type = std::queue< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container() const
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1582,35 +7182,38 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SchemaHash< typename Type::container_type >;
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Serializer << Element;
-		}
+		a_Serializer << reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Sizer& Element;
-		}
+		a_Sizer& reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::set< Args... > >
+class Deserializer< std::queue< Args... > >
 {
-	using Type = std::set< Args... >;
+	using Type = std::queue< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container()
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1629,24 +7232,24 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-
-		for ( size_t i = 0; i < Size; ++i )
-		{
-			typename Type::value_type Value;
-			a_Deserializer >> Value;
-			m_Deserializable->emplace( Value );
-		}
+		a_Deserializer >> reinterpret_cast< Access* >( m_Deserializable )->_Get_Container();
 	}
 
 	Type* m_Deserializable;
 };
 
 template < typename... Args >
-class Serializer< std::multiset< Args... > >
+class Serializer< std::priority_queue< Args... > >
 {
-	using Type = std::multiset< Args... >;
+	using Type = std::priority_queue< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container() const
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1662,35 +7265,38 @@ private:
 
 	friend class Serialization;
 
+	static constexpr uint64_t SchemaHash()
+	{
+		return Serialization::SchemaHash< typename Type::container_type >;
+	}
+
 	template < typename _StreamSerializer >
 	void Serialize( _StreamSerializer& a_Serializer ) const
 	{
-		a_Serializer << m_Serializable->size();
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Serializer << Element;
-		}
+		a_Serializer << reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	template < typename _Sizer >
 	void SizeOf( _Sizer& a_Sizer ) const
 	{
-		a_Sizer += sizeof( size_t );
-
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Sizer& Element;
-		}
+		a_Sizer& reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
 	}
 
 	const Type* m_Serializable;
 };
 
 template < typename... Args >
-class Deserializer< std::multiset< Args... > >
+class Deserializer< std::priority_queue< Args... > >
 {
-	using Type = std::multiset< Args... >;
+	using Type = std::priority_queue< Args... >;
+
+	struct Access : Type
+	{
+		auto& _Get_Container()
+		{
+			return Type::c;
+		}
+	};
 
 public:
 
@@ -1709,378 +7315,635 @@ private:
 	template < typename _StreamDeserializer >
 	void Deserialize( _StreamDeserializer& a_Deserializer ) const
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		a_Deserializer >> reinterpret_cast< Access* >( m_Deserializable )->_Get_Container();
+	}
 
-		for ( size_t i = 0; i < Size; ++i )
+	Type* m_Deserializable;
+};
+
+template < typename T >
+class DeltaSerializer
+{
+public:
+
+	template < typename _StreamSerializer >
+	static void Serialize( const T& a_Value, const T& a_Base, _StreamSerializer& a_Serializer )
+	{
+		bool Changed = Serialization::IsChanged( a_Value, a_Base );
+		a_Serializer << Changed;
+
+		if ( Changed )
 		{
-			typename Type::value_type Value;
-			a_Deserializer >> Value;
-			m_Deserializable->emplace( Value );
+			a_Serializer << a_Value;
 		}
 	}
 
-	Type* m_Deserializable;
+	template < typename _StreamDeserializer >
+	static void Deserialize( T& a_Value, _StreamDeserializer& a_Deserializer )
+	{
+		bool Changed = false;
+		a_Deserializer >> Changed;
+
+		if ( Changed )
+		{
+			Serialization::Clear( a_Value );
+			a_Deserializer >> a_Value;
+		}
+	}
 };
 
-template < typename... Args >
-class Serializer< std::unordered_set< Args... > >
+// The new size, then the changed and appended elements, each preceded by the number of unchanged elements before it.
+template < typename T >
+class SequenceDeltaSerializer
 {
-	using Type = std::unordered_set< Args... >;
-
 public:
 
-	Serializer( const Type& a_Serializable )
-		: m_Serializable( &a_Serializable )
-	{}
+	template < typename _StreamSerializer >
+	static void Serialize( const T& a_Value, const T& a_Base, _StreamSerializer& a_Serializer )
+	{
+		std::vector< size_t > Changed;
 
-	Serializer( const Type* a_Serializable )
-		: m_Serializable( a_Serializable )
-	{}
+		for ( size_t i = 0; i < a_Value.size(); ++i )
+		{
+			if ( i >= a_Base.size() || Serialization::IsChanged( a_Value[ i ], a_Base[ i ] ) )
+			{
+				Changed.push_back( i );
+			}
+		}
 
-private:
+		a_Serializer.WriteSizePrefix( a_Value.size() );
+		a_Serializer.WriteSizePrefix( Changed.size() );
 
-	friend class Serialization;
+		size_t Next = 0;
 
-	template < typename _StreamSerializer >
-	void Serialize( _StreamSerializer& a_Serializer ) const
+		for ( size_t Index : Changed )
+		{
+			a_Serializer.WriteSizePrefix( Index - Next );
+			a_Serializer << a_Value[ Index ];
+			Next = Index + 1;
+		}
+	}
+
+	template < typename _StreamDeserializer >
+	static void Deserialize( T& a_Value, _StreamDeserializer& a_Deserializer )
 	{
-		a_Serializer << m_Serializable->size();
+		size_t Size = a_Deserializer.ReadSizePrefix();
+		size_t Count = a_Deserializer.ReadSizePrefix();
+		a_Value.resize( Size );
 
-		for ( auto& Element : *m_Serializable )
+		size_t Index = 0;
+
+		for ( size_t i = 0; i < Count; ++i )
 		{
-			a_Serializer << Element;
+			Index += a_Deserializer.ReadSizePrefix();
+			SERIALIZATION_CHECK( Index < Size, "Delta element index is out of range." );
+
+			Serialization::Clear( a_Value[ Index ] );
+			a_Deserializer >> a_Value[ Index ];
+			++Index;
 		}
 	}
+};
 
-	template < typename _Sizer >
-	void SizeOf( _Sizer& a_Sizer ) const
+// The keys removed since the base, then the entries that were added or changed.
+template < typename T >
+class MapDeltaSerializer
+{
+public:
+
+	template < typename _StreamSerializer >
+	static void Serialize( const T& a_Value, const T& a_Base, _StreamSerializer& a_Serializer )
 	{
-		a_Sizer += sizeof( size_t );
+		std::vector< const typename T::key_type* > Removed;
+		std::vector< const typename T::value_type* > Changed;
 
-		for ( auto& Element : *m_Serializable )
+		for ( const auto& Pair : a_Base )
 		{
-			a_Sizer& Element;
+			if ( a_Value.find( Pair.first ) == a_Value.end() )
+			{
+				Removed.push_back( &Pair.first );
+			}
+		}
+
+		for ( const auto& Pair : a_Value )
+		{
+			auto Base = a_Base.find( Pair.first );
+
+			if ( Base == a_Base.end() || Serialization::IsChanged( Pair.second, Base->second ) )
+			{
+				Changed.push_back( &Pair );
+			}
+		}
+
+		a_Serializer.WriteSizePrefix( Removed.size() );
+
+		for ( const auto* Key : Removed )
+		{
+			a_Serializer << *Key;
+		}
+
+		a_Serializer.WriteSizePrefix( Changed.size() );
+
+		for ( const auto* Pair : Changed )
+		{
+			a_Serializer << Pair->first << Pair->second;
 		}
 	}
 
-	const Type* m_Serializable;
+	template < typename _StreamDeserializer >
+	static void Deserialize( T& a_Value, _StreamDeserializer& a_Deserializer )
+	{
+		size_t Count = a_Deserializer.ReadSizePrefix();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			typename T::key_type Key = Serialization::Construct< typename T::key_type >( a_Value.get_allocator() );
+			a_Deserializer >> Key;
+			a_Value.erase( Key );
+		}
+
+		Count = a_Deserializer.ReadSizePrefix();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			typename T::key_type Key = Serialization::Construct< typename T::key_type >( a_Value.get_allocator() );
+			a_Deserializer >> Key;
+
+			auto Iterator = a_Value.find( Key );
+
+			if ( Iterator == a_Value.end() )
+			{
+				Iterator = a_Value.try_emplace( std::move( Key ) ).first;
+			}
+			else
+			{
+				Serialization::Clear( Iterator->second );
+			}
+
+			a_Deserializer >> Iterator->second;
+		}
+	}
 };
 
-template < typename... Args >
-class Deserializer< std::unordered_set< Args... > >
+// The keys removed since the base, then the keys that were added.
+template < typename T >
+class SetDeltaSerializer
 {
-	using Type = std::unordered_set< Args... >;
-
 public:
 
-	Deserializer( Type& a_Deserializable )
-		: m_Deserializable( &a_Deserializable )
-	{}
+	template < typename _StreamSerializer >
+	static void Serialize( const T& a_Value, const T& a_Base, _StreamSerializer& a_Serializer )
+	{
+		std::vector< const typename T::key_type* > Removed;
+		std::vector< const typename T::key_type* > Added;
 
-	Deserializer( Type* a_Deserializable )
-		: m_Deserializable( a_Deserializable )
-	{}
+		for ( const auto& Key : a_Base )
+		{
+			if ( a_Value.find( Key ) == a_Value.end() )
+			{
+				Removed.push_back( &Key );
+			}
+		}
 
-private:
+		for ( const auto& Key : a_Value )
+		{
+			if ( a_Base.find( Key ) == a_Base.end() )
+			{
+				Added.push_back( &Key );
+			}
+		}
 
-	friend class Serialization;
+		a_Serializer.WriteSizePrefix( Removed.size() );
+
+		for ( const auto* Key : Removed )
+		{
+			a_Serializer << *Key;
+		}
+
+		a_Serializer.WriteSizePrefix( Added.size() );
+
+		for ( const auto* Key : Added )
+		{
+			a_Serializer << *Key;
+		}
+	}
 
 	template < typename _StreamDeserializer >
-	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	static void Deserialize( T& a_Value, _StreamDeserializer& a_Deserializer )
 	{
-		size_t Size;
-		a_Deserializer >> Size;
+		size_t Count = a_Deserializer.ReadSizePrefix();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			typename T::key_type Key = Serialization::Construct< typename T::key_type >( a_Value.get_allocator() );
+			a_Deserializer >> Key;
+			a_Value.erase( Key );
+		}
+
+		Count = a_Deserializer.ReadSizePrefix();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			typename T::key_type Key = Serialization::Construct< typename T::key_type >( a_Value.get_allocator() );
+			a_Deserializer >> Key;
+			a_Value.emplace( std::move( Key ) );
+		}
+	}
+};
+
+template < typename... Args >
+class DeltaSerializer< std::vector< Args... > > : public SequenceDeltaSerializer< std::vector< Args... > >
+{ };
+
+template < typename... Args >
+class DeltaSerializer< std::deque< Args... > > : public SequenceDeltaSerializer< std::deque< Args... > >
+{ };
+
+template < typename... Args >
+class DeltaSerializer< std::map< Args... > > : public MapDeltaSerializer< std::map< Args... > >
+{ };
 
-		for ( size_t i = 0; i < Size; ++i )
-		{
-			typename Type::value_type Value;
-			a_Deserializer >> Value;
-			m_Deserializable->emplace( Value );
-		}
-	}
+template < typename... Args >
+class DeltaSerializer< std::unordered_map< Args... > > : public MapDeltaSerializer< std::unordered_map< Args... > >
+{ };
 
-	Type* m_Deserializable;
-};
+template < typename... Args >
+class DeltaSerializer< std::set< Args... > > : public SetDeltaSerializer< std::set< Args... > >
+{ };
 
 template < typename... Args >
-class Serializer< std::unordered_multiset< Args... > >
+class DeltaSerializer< std::unordered_set< Args... > > : public SetDeltaSerializer< std::unordered_set< Args... > >
+{ };
+
+template < typename T, typename _Serializer >
+inline void Serialization::SerializeDelta( const T& a_Value, const T& a_Base, _Serializer& a_Serializer )
 {
-	using Type = std::unordered_multiset< Args... >;
+	DeltaSerializer< T >::Serialize( a_Value, a_Base, a_Serializer );
+}
 
+template < typename T, typename _Deserializer >
+inline void Serialization::DeserializeDelta( T& a_Value, _Deserializer& a_Deserializer )
+{
+	DeltaSerializer< T >::Deserialize( a_Value, a_Deserializer );
+}
+
+// An input iterator over a reader's Next( Element& ), for range-for loops. The element is stored in the reader.
+template < typename _Reader >
+class ReaderIterator
+{
 public:
 
-	Serializer( const Type& a_Serializable )
-		: m_Serializable( &a_Serializable )
-	{}
+	using Element           = typename _Reader::Element;
+	using iterator_category = std::input_iterator_tag;
+	using value_type        = Element;
+	using difference_type   = ptrdiff_t;
+	using pointer           = Element*;
+	using reference         = Element&;
 
-	Serializer( const Type* a_Serializable )
-		: m_Serializable( a_Serializable )
-	{}
+	ReaderIterator( _Reader* a_Reader )
+		: m_Reader( a_Reader )
+	{
+		Advance();
+	}
 
-private:
+	inline Element& operator * () const
+	{
+		return m_Reader->m_Current;
+	}
 
-	friend class Serialization;
+	inline Element* operator -> () const
+	{
+		return &m_Reader->m_Current;
+	}
 
-	template < typename _StreamSerializer >
-	void Serialize( _StreamSerializer& a_Serializer ) const
+	inline ReaderIterator& operator ++ ()
 	{
-		a_Serializer << m_Serializable->size();
+		Advance();
+		return *this;
+	}
 
-		for ( auto& Element : *m_Serializable )
-		{
-			a_Serializer << Element;
-		}
+	inline bool operator == ( const ReaderIterator& a_Other ) const
+	{
+		return m_Reader == a_Other.m_Reader;
 	}
 
-	template < typename _Sizer >
-	void SizeOf( _Sizer& a_Sizer ) const
+	inline bool operator != ( const ReaderIterator& a_Other ) const
 	{
-		a_Sizer += sizeof( size_t );
+		return m_Reader != a_Other.m_Reader;
+	}
 
-		for ( auto& Element : *m_Serializable )
+private:
+
+	void Advance()
+	{
+		if ( m_Reader && !m_Reader->Next( m_Reader->m_Current ) )
 		{
-			a_Sizer& Element;
+			m_Reader = nullptr;
 		}
 	}
 
-	const Type* m_Serializable;
+	_Reader* m_Reader;
 };
 
-template < typename... Args >
-class Deserializer< std::unordered_multiset< Args... > >
+// Hands out the elements of a serialized _Container one at a time, or in batches, holding only the current element.
+// Maps yield std::pair< key_type, mapped_type >. The deserializer must not be used for anything else until the reader is done.
+template < typename _Container, typename _Deserializer >
+class ElementReader
 {
-	using Type = std::unordered_multiset< Args... >;
-
-public:
+	template < typename T, typename = void >
+	struct _ElementOf
+	{
+		using Type = typename T::value_type;
+	};
 
-	Deserializer( Type& a_Deserializable )
-		: m_Deserializable( &a_Deserializable )
-	{}
+	template < typename T >
+	struct _ElementOf< T, std::void_t< typename T::mapped_type > >
+	{
+		using Type = std::pair< typename T::key_type, typename T::mapped_type >;
+	};
 
-	Deserializer( Type* a_Deserializable )
-		: m_Deserializable( a_Deserializable )
-	{}
+public:
 
-private:
+	using Element = typename _ElementOf< _Container >::Type;
 
-	friend class Serialization;
+	using Iterator = ReaderIterator< ElementReader >;
 
-	template < typename _StreamDeserializer >
-	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	ElementReader( _Deserializer& a_Deserializer )
+		: m_Deserializer( &a_Deserializer )
+		, m_Size( a_Deserializer.ReadSizePrefix() )
+		, m_Remaining( m_Size )
+		, m_Current()
 	{
-		size_t Size;
-		a_Deserializer >> Size;
-
-		for ( size_t i = 0; i < Size; ++i )
+		if ( _IsChunked( ( _Container* )nullptr ) && a_Deserializer.HasChunkIndex() )
 		{
-			typename Type::value_type Value;
-			a_Deserializer >> Value;
-			m_Deserializable->emplace( Value );
+			for ( size_t Chunks = a_Deserializer.ReadSizePrefix(); Chunks; --Chunks )
+			{
+				a_Deserializer.ReadSizePrefix();
+			}
 		}
 	}
 
-	Type* m_Deserializable;
-};
+	inline size_t Size() const
+	{
+		return m_Size;
+	}
 
-template < typename... Args >
-class Serializer< std::stack< Args... > >
-{
-	using Type = std::stack< Args... >;
+	inline size_t Remaining() const
+	{
+		return m_Remaining;
+	}
 
-public:
+	// Reads the next element into a_Value, reusing its memory, or returns false at the end.
+	bool Next( Element& a_Value )
+	{
+		if ( !m_Remaining )
+		{
+			return false;
+		}
 
-	Serializer( const Type& a_Serializable )
-		: m_Serializable( &a_Serializable )
-	{}
+		Serialization::Clear( a_Value );
+		*m_Deserializer >> a_Value;
+		--m_Remaining;
+		return true;
+	}
 
-	Serializer( const Type* a_Serializable )
-		: m_Serializable( a_Serializable )
-	{}
+	// Reads up to a_Count elements into a_Values and returns how many were read.
+	size_t Read( Element* a_Values, size_t a_Count )
+	{
+		a_Count = a_Count < m_Remaining ? a_Count : m_Remaining;
 
-private:
+		if constexpr ( Serialization::IsTriviallySerializable< Element > )
+		{
+			m_Deserializer->ReadValues( a_Values, a_Count );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_Count; ++i )
+			{
+				Serialization::Clear( a_Values[ i ] );
+				*m_Deserializer >> a_Values[ i ];
+			}
+		}
 
-	friend class Serialization;
+		m_Remaining -= a_Count;
+		return a_Count;
+	}
 
-	template < typename _StreamSerializer >
-	void Serialize( _StreamSerializer& a_Serializer ) const
+	inline Iterator begin()
 	{
-		a_Serializer << m_Serializable->_Get_container();
+		return Iterator( this );
 	}
 
-	template < typename _Sizer >
-	void SizeOf( _Sizer& a_Sizer ) const
+	inline Iterator end()
 	{
-		a_Sizer& m_Serializable->_Get_container();
+		return Iterator( nullptr );
 	}
 
-	const Type* m_Serializable;
-};
-
-template < typename... Args >
-class Deserializer< std::stack< Args... > >
-{
-	using Type = std::stack< Args... >;
+private:
 
-public:
+	friend class ReaderIterator< ElementReader >;
 
-	Deserializer( Type& a_Deserializable )
-		: m_Deserializable( &a_Deserializable )
-	{}
+	// Whether the serializer of the container writes a chunk index ahead of its elements.
+	template < typename T >
+	static constexpr bool _IsChunked( T* )
+	{
+		return false;
+	}
 
-	Deserializer( Type* a_Deserializable )
-		: m_Deserializable( a_Deserializable )
-	{}
+	template < typename... Args >
+	static constexpr bool _IsChunked( std::vector< Args... >* )
+	{
+		return !Serialization::IsTriviallySerializable< typename std::vector< Args... >::value_type >;
+	}
 
-private:
+	template < typename... Args >
+	static constexpr bool _IsChunked( std::deque< Args... >* )
+	{
+		return true;
+	}
 
-	friend class Serialization;
+	template < typename... Args >
+	static constexpr bool _IsChunked( std::map< Args... >* )
+	{
+		return true;
+	}
 
-	template < typename _StreamDeserializer >
-	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	template < typename... Args >
+	static constexpr bool _IsChunked( std::unordered_map< Args... >* )
 	{
-		a_Deserializer >> const_cast< typename Type::container_type& >( m_Deserializable->_Get_container() );
+		return true;
 	}
 
-	Type* m_Deserializable;
+	_Deserializer* m_Deserializer;
+	size_t         m_Size;
+	size_t         m_Remaining;
+	Element        m_Current;
 };
 
-template < typename... Args >
-class Serializer< std::queue< Args... > >
+template < typename _Container, typename _Deserializer >
+inline ElementReader< _Container, _Deserializer > Serialization::ReadElements( _Deserializer& a_Deserializer )
+{
+	return ElementReader< _Container, _Deserializer >( a_Deserializer );
+}
+
+// Appends elements to an unbounded sequence in blocks of a_BlockCount elements, each written as a fixed size header of
+// element count and byte size followed by the elements. Nothing is ever rewritten, so a sequence can be extended by
+// seeking to the end of an existing one, and a SequenceReader can follow the file while it is being written.
+template < typename T, typename _Stream >
+class SequenceWriter
 {
-	using Type = std::queue< Args... >;
-
 public:
 
-	Serializer( const Type& a_Serializable )
-		: m_Serializable( &a_Serializable )
-	{}
-
-	Serializer( const Type* a_Serializable )
-		: m_Serializable( a_Serializable )
-	{}
-
-private:
-
-	friend class Serialization;
+	static constexpr size_t DefaultBlockCount = 1024;
 
-	template < typename _StreamSerializer >
-	void Serialize( _StreamSerializer& a_Serializer ) const
+	SequenceWriter( StreamSerializer< _Stream >& a_Serializer, size_t a_BlockCount = DefaultBlockCount )
+		: m_Serializer( &a_Serializer )
+		, m_BlockCount( a_BlockCount ? a_BlockCount : 1 )
+		, m_Count( 0 )
+		, m_Total( 0 )
 	{
-		a_Serializer << m_Serializable->_Get_container();
+		m_Block.SetSizeEncoding( a_Serializer.GetSizeEncoding() );
+		m_Block.SetByteOrder( a_Serializer.GetByteOrder() );
+		m_Block.SetChunkIndex( a_Serializer.GetChunkSize() );
 	}
 
-	template < typename _Sizer >
-	void SizeOf( _Sizer& a_Sizer ) const
+	~SequenceWriter()
 	{
-		a_Sizer& m_Serializable->_Get_container();
+		Flush();
 	}
 
-	const Type* m_Serializable;
-};
-
-template < typename... Args >
-class Deserializer< std::queue< Args... > >
-{
-	using Type = std::queue< Args... >;
+	void Append( const T& a_Value )
+	{
+		m_Block << a_Value;
+		++m_Total;
 
-public:
+		if ( ++m_Count == m_BlockCount )
+		{
+			Flush();
+		}
+	}
 
-	Deserializer( Type& a_Deserializable )
-		: m_Deserializable( &a_Deserializable )
-	{}
+	// Writes the pending elements as a block and flushes the stream, so that readers can see them.
+	void Flush()
+	{
+		if ( !m_Count )
+		{
+			return;
+		}
 
-	Deserializer( Type* a_Deserializable )
-		: m_Deserializable( a_Deserializable )
-	{}
+		uint64_t Header[ 2 ] = { m_Count, m_Block.GetStream().Size() };
+		m_Serializer->WriteValues( Header, 2 );
+		m_Serializer->GetStream().Write( m_Block.GetStream().Data(), m_Block.GetStream().Size() );
 
-private:
+		if constexpr ( Serialization::HasFlush< _Stream > )
+		{
+			m_Serializer->GetStream().Flush();
+		}
 
-	friend class Serialization;
+		m_Block.GetStream().Reset();
+		m_Count = 0;
+	}
 
-	template < typename _StreamDeserializer >
-	void Deserialize( _StreamDeserializer& a_Deserializer ) const
+	inline size_t Count() const
 	{
-		a_Deserializer >> const_cast< typename Type::container_type& >( m_Deserializable->_Get_container() );
+		return m_Total;
 	}
 
-	Type* m_Deserializable;
+private:
+
+	SequenceWriter( SequenceWriter&& ) = delete;
+
+	StreamSerializer< _Stream >* m_Serializer;
+	BufferSerializer             m_Block;
+	size_t                       m_BlockCount;
+	size_t                       m_Count;
+	size_t                       m_Total;
 };
 
-template < typename... Args >
-class Serializer< std::priority_queue< Args... > >
+// Reads a sequence written by a SequenceWriter. Next returns false at the end of the data that is complete so far, and
+// can be called again once the writer has appended more blocks.
+template < typename T, typename _Stream >
+class SequenceReader
 {
-	using Type = std::priority_queue< Args... >;
+public:
 
-	struct Access : Type
+	using Element  = T;
+	using Iterator = ReaderIterator< SequenceReader >;
+
+	SequenceReader( StreamDeserializer< _Stream >& a_Deserializer )
+		: m_Deserializer( &a_Deserializer )
+		, m_Remaining( 0 )
+		, m_Total( 0 )
+		, m_Current()
+	{ }
+
+	bool Next( T& a_Value )
 	{
-		auto& _Get_Container() const
+		if ( !m_Remaining && !NextBlock() )
 		{
-			return Type::c;
+			return false;
 		}
-	};
-
-public:
-
-	Serializer( const Type& a_Serializable )
-		: m_Serializable( &a_Serializable )
-	{}
-
-	Serializer( const Type* a_Serializable )
-		: m_Serializable( a_Serializable )
-	{}
 
-private:
+		Serialization::Clear( a_Value );
+		*m_Deserializer >> a_Value;
+		--m_Remaining;
+		++m_Total;
+		return true;
+	}
 
-	friend class Serialization;
+	// The number of elements read so far.
+	inline size_t Count() const
+	{
+		return m_Total;
+	}
 
-	template < typename _StreamSerializer >
-	void Serialize( _StreamSerializer& a_Serializer ) const
+	inline Iterator begin()
 	{
-		a_Serializer << reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
+		return Iterator( this );
 	}
 
-	template < typename _Sizer >
-	void SizeOf( _Sizer& a_Sizer ) const
+	inline Iterator end()
 	{
-		a_Sizer& reinterpret_cast< const Access* >( m_Serializable )->_Get_Container();
+		return Iterator( nullptr );
 	}
 
-	const Type* m_Serializable;
-};
+private:
 
-template < typename... Args >
-class Deserializer< std::priority_queue< Args... > >
-{
-	using Type = std::priority_queue< Args... >;
+	friend class ReaderIterator< SequenceReader >;
 
-	struct Access : Type
+	// Moves to the next block when it has been written completely, and leaves the stream where it was otherwise.
+	bool NextBlock()
 	{
-		auto& _Get_Container()
-		{
-			return Type::c;
-		}
-	};
+		_Stream& Stream = m_Deserializer->GetStream();
 
-public:
+		do
+		{
+			size_t Position = Stream.Position();
+			size_t Size = Stream.Size();
+			uint64_t Header[ 2 ];
 
-	Deserializer( Type& a_Deserializable )
-		: m_Deserializable( &a_Deserializable )
-	{}
+			if ( Position + sizeof( Header ) > Size )
+			{
+				return false;
+			}
 
-	Deserializer( Type* a_Deserializable )
-		: m_Deserializable( a_Deserializable )
-	{}
+			m_Deserializer->ReadValues( Header, 2 );
 
-private:
+			if ( Position + sizeof( Header ) + Header[ 1 ] > Size )
+			{
+				Stream.Seek( Position );
+				return false;
+			}
 
-	friend class Serialization;
+			m_Remaining = ( size_t )Header[ 0 ];
+		}
+		while ( !m_Remaining );
 
-	template < typename _StreamDeserializer >
-	void Deserialize( _StreamDeserializer& a_Deserializer ) const
-	{
-		a_Deserializer >> reinterpret_cast< Access* >( m_Deserializable )->_Get_Container();
+		return true;
 	}
 
-	Type* m_Deserializable;
-};
\ No newline at end of file
+	StreamDeserializer< _Stream >* m_Deserializer;
+	size_t                         m_Remaining;
+	size_t                         m_Total;
+	T                              m_Current;
+};